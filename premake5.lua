@@ -5,7 +5,7 @@ workspace "ComputerGraphics"
     flags { "MultiProcessorCompile" }
 
     filter "configurations:Debug"
-        defines { "DEBUG", "DEBUG_SHADER" }
+        defines { "DEBUG", "DEBUG_SHADER", "CG_GL_STATE_STATS" }
         symbols "On"
 
     filter "configurations:Release"
@@ -37,6 +37,34 @@ project "CG"
     filter "system:windows"
         defines { "_WINDOWS" }
 
+    filter {}
+
+project "TexConv"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+	architecture "x86_64"
+
+    targetdir "bin/%{cfg.buildcfg}"
+    objdir "obj/%{cfg.buildcfg}"
+
+    includedirs { "src/" }
+
+    files { "tools/texconv.cpp", "src/vendor/stb_image.cpp" }
+
+project "ResPack"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+	architecture "x86_64"
+
+    targetdir "bin/%{cfg.buildcfg}"
+    objdir "obj/%{cfg.buildcfg}"
+
+    includedirs { "src/" }
+
+    files { "tools/respack.cpp", "src/inflate.cpp" }
+
 include "dependencies/glfw.lua"
 include "dependencies/glad.lua"
 include "dependencies/glm.lua"
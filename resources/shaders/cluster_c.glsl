@@ -0,0 +1,132 @@
+#version 460 core
+
+// Assigns point lights to the clusters of the view frustum (see lighting.cpp).
+// One work group per depth slice, one invocation per cluster of the slice.
+// Lights are loaded in batches; the batch is first culled against the whole slice
+// and only the survivors are tested against each cluster AABB in view space.
+
+layout(local_size_x = 16, local_size_y = 9) in;     // Must match CLUSTER_GRID_X/Y in lighting.h
+
+const uint MAX_CLUSTER_LIGHTS = 128;    // Must match MAX_CLUSTER_LIGHTS in lighting.h
+
+struct PointLight
+{
+    vec4 position_radius;       // World position, radius
+    vec4 color_intensity;
+};
+
+layout(std140, binding = 0) uniform ClusterParams
+{
+    uvec4 u_grid;               // Cluster counts, w - number of lights
+    vec4 u_screen;              // Screen size, tile size in pixels
+    vec4 u_depth;               // Near, far, slice scale, slice bias
+    mat4 u_cluster_view;
+    mat4 u_inverse_projection;
+};
+
+layout(std430, binding = 2) readonly buffer Lights
+{
+    PointLight lights[];
+};
+
+layout(std430, binding = 3) writeonly buffer ClusterCounts
+{
+    uint cluster_counts[];
+};
+
+layout(std430, binding = 4) writeonly buffer ClusterLights
+{
+    uint cluster_lights[];
+};
+
+shared vec4 s_lights[gl_WorkGroupSize.x * gl_WorkGroupSize.y];     // View position, radius
+shared uint s_indices[gl_WorkGroupSize.x * gl_WorkGroupSize.y];
+shared uint s_count;
+
+// Point on the view ray through an NDC position at the given view depth
+vec3 view_point(vec2 ndc, float depth)
+{
+    vec4 near_point = u_inverse_projection * vec4(ndc, -1.0, 1.0);
+    vec3 ray = near_point.xyz / near_point.w;
+    return ray * (depth / -ray.z);
+}
+
+// View space bounds of the frustum part between two NDC corners and two depths
+void frustum_bounds(vec2 ndc_min, vec2 ndc_max, float near_depth, float far_depth, out vec3 aabb_min, out vec3 aabb_max)
+{
+    aabb_min = vec3(1e30);
+    aabb_max = vec3(-1e30);
+    for (int corner = 0; corner < 8; corner++)
+    {
+        vec2 ndc = vec2((corner & 1) != 0 ? ndc_max.x : ndc_min.x, (corner & 2) != 0 ? ndc_max.y : ndc_min.y);
+        vec3 point = view_point(ndc, (corner & 4) != 0 ? far_depth : near_depth);
+        aabb_min = min(aabb_min, point);
+        aabb_max = max(aabb_max, point);
+    }
+}
+
+// Sphere against AABB: distance to the closest point of the box
+bool intersects(vec4 sphere, vec3 aabb_min, vec3 aabb_max)
+{
+    vec3 offset = sphere.xyz - clamp(sphere.xyz, aabb_min, aabb_max);
+    return dot(offset, offset) <= sphere.w * sphere.w;
+}
+
+void main()
+{
+    uint x = gl_LocalInvocationID.x;
+    uint y = gl_LocalInvocationID.y;
+    uint z = gl_WorkGroupID.x;
+    uint index = x + u_grid.x * (y + u_grid.y * z);
+    uint group_size = gl_WorkGroupSize.x * gl_WorkGroupSize.y;
+
+    // Exponential depth slices, matching the slice lookup in tex_f.glsl
+    float ratio = u_depth.y / u_depth.x;
+    float near_depth = u_depth.x * pow(ratio, float(z) / float(u_grid.z));
+    float far_depth = u_depth.x * pow(ratio, float(z + 1) / float(u_grid.z));
+
+    vec3 slice_min, slice_max;
+    frustum_bounds(vec2(-1.0), vec2(1.0), near_depth, far_depth, slice_min, slice_max);
+
+    vec3 aabb_min, aabb_max;
+    frustum_bounds(vec2(x, y) / vec2(u_grid.xy) * 2.0 - 1.0,
+        vec2(x + 1, y + 1) / vec2(u_grid.xy) * 2.0 - 1.0,
+        near_depth, far_depth, aabb_min, aabb_max);
+
+    uint count = 0;
+    uint light_count = u_grid.w;
+    for (uint base = 0; base < light_count; base += group_size)
+    {
+        if (gl_LocalInvocationIndex == 0)
+            s_count = 0;
+        barrier();
+
+        // Every invocation culls one light of the batch against the slice
+        uint light = base + gl_LocalInvocationIndex;
+        if (light < light_count)
+        {
+            vec4 position_radius = lights[light].position_radius;
+            vec4 sphere = vec4((u_cluster_view * vec4(position_radius.xyz, 1.0)).xyz, position_radius.w);
+            if (intersects(sphere, slice_min, slice_max))
+            {
+                uint slot = atomicAdd(s_count, 1u);
+                s_lights[slot] = sphere;
+                s_indices[slot] = light;
+            }
+        }
+        barrier();
+
+        uint batch = s_count;
+        for (uint i = 0; i < batch && count < MAX_CLUSTER_LIGHTS; i++)
+        {
+            if (intersects(s_lights[i], aabb_min, aabb_max))
+            {
+                cluster_lights[index * MAX_CLUSTER_LIGHTS + count] = s_indices[i];
+                count++;
+            }
+        }
+        barrier();
+    }
+
+    cluster_counts[index] = count;
+}
@@ -1,8 +1,20 @@
 #version 460 core
 
+// Variant defines are injected after the #version line by the C++ side:
+//   LIGHTING_PHONG - Phong lighting, otherwise the part is unlit
+//   TEXTURED       - the material color is multiplied by the material texture
+//   BINDLESS       - textures are sampled by handle (GL_ARB_bindless_texture),
+//                    otherwise by layer from u_textures
+
+#ifdef BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
+
 in vec3 v_normal;
 in vec3 v_frag_pos;
 in vec2 v_tex_coord;
+flat in uint v_material;
+in float v_view_depth;
 
 out vec4 frag_color;
 
@@ -10,73 +22,136 @@ uniform vec3 u_view_pos;
 uniform vec3 u_light_pos;
 uniform vec3 u_light_color;
 
-// Robot part colors
-uniform vec3 u_body_color = vec3(0.3, 0.5, 0.8);    // Blue body
-uniform vec3 u_head_color = vec3(0.4, 0.6, 0.9);    // Lighter blue head
-uniform vec3 u_arm_color = vec3(0.2, 0.4, 0.7);     // Darker blue arms
-uniform vec3 u_leg_color = vec3(0.2, 0.4, 0.7);     // Darker blue legs
-uniform vec3 u_eye_color = vec3(1.0, 0.0, 0.0);     // Bright red eyes
-uniform vec3 u_antenna_color = vec3(1.0, 1.0, 0.0); // Yellow antenna
-uniform vec3 u_shoulder_color = vec3(0.3, 0.5, 0.8); // Shoulder color
-uniform vec3 u_hip_color = vec3(0.3, 0.5, 0.8);     // Hip color
+#ifndef BINDLESS
+uniform sampler2DArray u_textures;      // All textures as layers of one array
+#endif
+
+// Material palette shared by all instances (see GpuMaterial in material.cpp)
+struct Material
+{
+    vec4 color;
+    float emissive;             // 1.0 for self-illuminating parts (eyes)
+    float specular_strength;
+    float shininess;
+    uint texture_layer;         // Layer in u_textures
+    uvec2 texture_handle;       // Bindless handle
+    uvec2 padding;
+};
+
+layout(std430, binding = 0) readonly buffer Materials
+{
+    Material materials[];
+};
+
+#if defined(LIGHTING_PHONG)
+// Clustered point lights (see lighting.cpp and cluster_c.glsl)
+const uint MAX_CLUSTER_LIGHTS = 128;
+
+struct PointLight
+{
+    vec4 position_radius;       // World position, radius
+    vec4 color_intensity;
+};
+
+layout(std140, binding = 0) uniform ClusterParams
+{
+    uvec4 u_grid;               // Cluster counts, w - number of lights
+    vec4 u_screen;              // Screen size, tile size in pixels
+    vec4 u_depth;               // Near, far, slice scale, slice bias
+    mat4 u_cluster_view;
+    mat4 u_inverse_projection;
+};
+
+layout(std430, binding = 2) readonly buffer Lights
+{
+    PointLight lights[];
+};
+
+layout(std430, binding = 3) readonly buffer ClusterCounts
+{
+    uint cluster_counts[];
+};
 
-// Which robot part are we drawing? (passed from C++ code)
-uniform int u_robot_part;
+layout(std430, binding = 4) readonly buffer ClusterLights
+{
+    uint cluster_lights[];
+};
 
-vec3 get_part_color_based_on_id()
+// Diffuse and specular light of the point lights in this fragment's cluster
+vec3 point_lighting(vec3 norm, vec3 view_dir, float specular_strength, float shininess)
 {
-    // Use the uniform to determine color - much more reliable
-    switch(u_robot_part) {
-        case 0: return u_body_color;      // Body
-        case 1: return u_head_color;      // Head
-        case 2: return u_arm_color;       // Arms
-        case 3: return u_leg_color;       // Legs
-        case 4: return u_eye_color;       // Eyes
-        case 5: return u_antenna_color;   // Antenna
-        case 6: return u_shoulder_color;  // Shoulders
-        case 7: return u_hip_color;       // Hips
-        case 8: return u_arm_color;       // Forearms
-        case 9: return u_leg_color;       // Shins
-        default: return vec3(0.5, 0.5, 0.5); // Fallback
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / u_screen.zw), u_grid.xy - 1u);
+    uint slice = uint(clamp(log(v_view_depth) * u_depth.z + u_depth.w, 0.0, float(u_grid.z - 1u)));
+    uint cluster = tile.x + u_grid.x * (tile.y + u_grid.y * slice);
+
+    vec3 result = vec3(0.0);
+    uint count = cluster_counts[cluster];
+    for (uint i = 0; i < count; i++)
+    {
+        PointLight light = lights[cluster_lights[cluster * MAX_CLUSTER_LIGHTS + i]];
+        vec3 to_light = light.position_radius.xyz - v_frag_pos;
+        float dist = length(to_light);
+        vec3 light_dir = to_light / max(dist, 1e-4);
+
+        // Smooth falloff that reaches zero at the radius
+        float attenuation = clamp(1.0 - dist / light.position_radius.w, 0.0, 1.0);
+        attenuation *= attenuation;
+
+        float diff = max(dot(norm, light_dir), 0.0);
+        float spec = pow(max(dot(view_dir, reflect(-light_dir, norm)), 0.0), shininess);
+        vec3 color = light.color_intensity.rgb * light.color_intensity.a * attenuation;
+        result += (diff + specular_strength * spec) * color;
     }
+    return result;
 }
+#endif
 
 void main()
 {
-    // Get the color based on robot part ID
-    vec3 object_color = get_part_color_based_on_id();
-    
-    // Enhanced lighting for eyes to make them stand out
-    if(u_robot_part == 4) { // Eyes
-        // Make eyes self-illuminating (no lighting calculations)
-        frag_color = vec4(u_eye_color * 1.2, 1.0);
-        return;
-    }
-    
-    // Standard lighting for other parts
-    
+    Material material = materials[v_material];
+    vec3 object_color = material.color.rgb;
+
+#ifdef TEXTURED
+#ifdef BINDLESS
+    vec4 texel = texture(sampler2D(material.texture_handle), v_tex_coord);
+#else
+    vec4 texel = texture(u_textures, vec3(v_tex_coord, material.texture_layer));
+#endif
+    // Transparent texels leave the material color untouched (decal)
+    object_color *= mix(vec3(1.0), texel.rgb, texel.a);
+#endif
+
+#if defined(LIGHTING_PHONG)
     // Ambient lighting - increased for better visibility
     float ambient_strength = 0.5; // Increased from 0.3
     vec3 ambient = ambient_strength * u_light_color;
-    
+
     // Diffuse lighting
     vec3 norm = normalize(v_normal);
     vec3 light_dir = normalize(u_light_pos - v_frag_pos);
     float diff = max(dot(norm, light_dir), 0.0);
     vec3 diffuse = diff * u_light_color;
-    
-    // Specular lighting - reduced to prevent harsh highlights
-    float specular_strength = 0.3; // Reduced from 0.5
+
+    // Specular lighting - strength and shininess come from the material
     vec3 view_dir = normalize(u_view_pos - v_frag_pos);
     vec3 reflect_dir = reflect(-light_dir, norm);
-    float spec = pow(max(dot(view_dir, reflect_dir), 0.0), 16.0); // Reduced shininess
-    vec3 specular = specular_strength * spec * u_light_color;
-    
+    float spec = pow(max(dot(view_dir, reflect_dir), 0.0), material.shininess);
+    vec3 specular = material.specular_strength * spec * u_light_color;
+
+    // Point lights from the cluster
+    vec3 points = point_lighting(norm, view_dir, material.specular_strength, material.shininess);
+
     // Combine results with better balance
-    vec3 result = (ambient + diffuse + specular) * object_color;
-    
+    vec3 result = (ambient + diffuse + specular + points) * object_color;
+
     // Add a tiny bit of gamma correction for better appearance
     result = pow(result, vec3(1.0/1.2));
-    
-    frag_color = vec4(result, 1.0);
-}
\ No newline at end of file
+#else
+    vec3 result = object_color;
+#endif
+
+    // Self-illuminating materials skip the lighting without a branch
+    result = mix(result, object_color * 1.2, material.emissive);
+
+    frag_color = vec4(result, material.color.a);
+}
@@ -1,22 +1,58 @@
 #version 460 core
 
-layout(location = 0) in vec3 a_pos;
-layout(location = 1) in vec3 a_normal;
-layout(location = 2) in vec2 a_tex_coord;
+// Vertices are pulled from a storage buffer, there are no vertex attributes.
+// Every mesh shares the same buffers and is drawn indexed with its base vertex,
+// so gl_VertexID is the index plus MeshRange::base_vertex - the vertex's place in the buffer.
+struct Vertex
+{
+    float position[3];
+    float normal[3];
+    float tex_coord[2];
+};
+
+layout(std430, binding = 5) readonly buffer Vertices
+{
+    Vertex vertices[];
+};
+
+// Per-instance data: model matrix and index into the material palette
+struct Instance
+{
+    mat4 model;
+    uint material;
+    uint padding0;
+    uint padding1;
+    uint padding2;
+};
+
+layout(std430, binding = 1) readonly buffer Instances
+{
+    Instance instances[];
+};
 
 out vec3 v_normal;
 out vec3 v_frag_pos;
 out vec2 v_tex_coord;
+flat out uint v_material;
+out float v_view_depth;         // Distance along the view direction, selects the light cluster
 
-uniform mat4 u_model;
 uniform mat4 u_view;
 uniform mat4 u_projection;
 
 void main()
 {
-    v_frag_pos = vec3(u_model * vec4(a_pos, 1.0));
-    v_normal = mat3(transpose(inverse(u_model))) * a_normal;
+    Instance instance = instances[gl_BaseInstance + gl_InstanceID];
+    Vertex vertex = vertices[gl_VertexID];
+    vec3 a_pos = vec3(vertex.position[0], vertex.position[1], vertex.position[2]);
+    vec3 a_normal = vec3(vertex.normal[0], vertex.normal[1], vertex.normal[2]);
+    vec2 a_tex_coord = vec2(vertex.tex_coord[0], vertex.tex_coord[1]);
+
+    v_frag_pos = vec3(instance.model * vec4(a_pos, 1.0));
+    v_normal = mat3(transpose(inverse(instance.model))) * a_normal;
     v_tex_coord = a_tex_coord;
+    v_material = instance.material;
     
-    gl_Position = u_projection * u_view * vec4(v_frag_pos, 1.0);
-}
\ No newline at end of file
+    vec4 view_pos = u_view * vec4(v_frag_pos, 1.0);
+    v_view_depth = -view_pos.z;
+    gl_Position = u_projection * view_pos;
+}
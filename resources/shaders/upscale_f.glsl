@@ -0,0 +1,73 @@
+#version 460 core
+
+// Upscales the scene from the used part of the offscreen target to the window.
+// Bilinear filtering, followed by an unsharp mask from the four neighbouring source
+// texels to restore some of the detail lost at low resolution.
+// The FXAA variant first smooths edges found from the luma of the neighbouring texels
+// (used when the scene is rendered with a single sample).
+
+in vec2 v_uv;
+
+out vec4 o_color;
+
+uniform sampler2D u_scene;
+uniform vec2 u_uv_scale;        // Used size / texture size
+uniform vec2 u_texel;           // 1 / texture size
+uniform float u_sharpness;      // 0 - plain bilinear
+
+// Clamped half a texel inside the used area, so the unused part never bleeds in
+vec3 scene(vec2 uv)
+{
+    return texture(u_scene, clamp(uv, u_texel * 0.5f, u_uv_scale - u_texel * 0.5f)).rgb;
+}
+
+#ifdef FXAA
+const float FXAA_REDUCE_MIN = 1.0f / 128.0f;
+const float FXAA_REDUCE_MUL = 1.0f / 8.0f;
+const float FXAA_SPAN_MAX = 8.0f;
+
+float luma(vec3 color)
+{
+    return dot(color, vec3(0.299f, 0.587f, 0.114f));
+}
+
+// Blends along the edge direction estimated from the four diagonal neighbours
+vec3 fxaa(vec2 uv, vec3 center)
+{
+    float luma_nw = luma(scene(uv + vec2(-1.0f, -1.0f) * u_texel));
+    float luma_ne = luma(scene(uv + vec2(1.0f, -1.0f) * u_texel));
+    float luma_sw = luma(scene(uv + vec2(-1.0f, 1.0f) * u_texel));
+    float luma_se = luma(scene(uv + vec2(1.0f, 1.0f) * u_texel));
+    float luma_m = luma(center);
+    float luma_min = min(luma_m, min(min(luma_nw, luma_ne), min(luma_sw, luma_se)));
+    float luma_max = max(luma_m, max(max(luma_nw, luma_ne), max(luma_sw, luma_se)));
+
+    vec2 dir = vec2(-((luma_nw + luma_ne) - (luma_sw + luma_se)), (luma_nw + luma_sw) - (luma_ne + luma_se));
+    float dir_reduce = max((luma_nw + luma_ne + luma_sw + luma_se) * 0.25f * FXAA_REDUCE_MUL, FXAA_REDUCE_MIN);
+    float dir_scale = 1.0f / (min(abs(dir.x), abs(dir.y)) + dir_reduce);
+    dir = clamp(dir * dir_scale, vec2(-FXAA_SPAN_MAX), vec2(FXAA_SPAN_MAX)) * u_texel;
+
+    vec3 near = 0.5f * (scene(uv + dir * (1.0f / 3.0f - 0.5f)) + scene(uv + dir * (2.0f / 3.0f - 0.5f)));
+    vec3 far = near * 0.5f + 0.25f * (scene(uv - dir * 0.5f) + scene(uv + dir * 0.5f));
+    float luma_far = luma(far);
+    return luma_far < luma_min || luma_far > luma_max ? near : far;
+}
+#endif
+
+void main()
+{
+    vec2 uv = v_uv * u_uv_scale;
+    vec3 color = scene(uv);
+#ifdef FXAA
+    color = fxaa(uv, color);
+#endif
+
+    if (u_sharpness > 0.0f)
+    {
+        vec3 blur = scene(uv + vec2(u_texel.x, 0.0f)) + scene(uv - vec2(u_texel.x, 0.0f)) +
+            scene(uv + vec2(0.0f, u_texel.y)) + scene(uv - vec2(0.0f, u_texel.y));
+        color = clamp(color + (color - blur * 0.25f) * u_sharpness, 0.0f, 1.0f);
+    }
+
+    o_color = vec4(color, 1.0f);
+}
@@ -0,0 +1,12 @@
+#version 460 core
+
+// Full screen triangle generated from gl_VertexID, no vertex buffer needed.
+
+out vec2 v_uv;
+
+void main()
+{
+    vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);   // (0,0), (2,0), (0,2)
+    v_uv = pos;
+    gl_Position = vec4(pos * 2.0f - 1.0f, 0.0f, 1.0f);
+}
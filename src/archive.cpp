@@ -0,0 +1,209 @@
+#include "archive.h"
+#include "archive_format.h"
+#include "embedded.h"
+#include "inflate.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <unordered_map>
+
+namespace cg
+{
+    constexpr uint64_t max_inflate_ratio = 1032;   // -    deflate (~1032:1)
+
+    /*
+     *   .  open_archive()   ,
+     *        .
+     */
+    static MappedFile g_archive;
+    static const ArchiveEntry* g_entries = nullptr;
+    static uint32_t g_entry_count = 0;
+    static const char* g_names = nullptr;
+
+    /*
+     *     close_archive(),
+     *           .
+     */
+    static std::mutex g_inflated_mutex;
+    static std::unordered_map<uint32_t, std::unique_ptr<unsigned char[]>> g_inflated;
+
+    static std::string_view entry_name(const ArchiveEntry& entry)
+    {
+        return std::string_view(g_names + entry.name_offset, entry.name_length);
+    }
+
+    /*
+     *       .
+     *      ,    
+     *  ,    .     
+     *   max_inflate_ratio   -    .
+     */
+    static bool validate_archive(const MappedFile& file)
+    {
+        if (file.size < sizeof(ArchiveHeader))
+            return false;
+
+        const auto* header = reinterpret_cast<const ArchiveHeader*>(file.data);
+        if (std::memcmp(header->magic, archive_magic, sizeof(header->magic)) != 0 ||
+            header->version != archive_version ||
+            sizeof(ArchiveHeader) + uint64_t(header->entry_count) * sizeof(ArchiveEntry) > file.size ||
+            header->names_size > file.size || header->names_offset > file.size - header->names_size)
+            return false;
+
+        const auto* entries = reinterpret_cast<const ArchiveEntry*>(header + 1);
+        const char* names = reinterpret_cast<const char*>(file.data + header->names_offset);
+        for (uint32_t i = 0; i < header->entry_count; i++)
+        {
+            const ArchiveEntry& entry = entries[i];
+            if (uint64_t(entry.name_offset) + entry.name_length > header->names_size ||
+                entry.size > file.size || entry.offset > file.size - entry.size ||
+                (entry.compression != ARCHIVE_STORED && entry.compression != ARCHIVE_ZLIB) ||
+                (entry.compression == ARCHIVE_STORED && entry.size != entry.original_size) ||
+                (entry.compression == ARCHIVE_ZLIB && entry.original_size / max_inflate_ratio > entry.size))
+                return false;
+
+            //         
+            if (i > 0)
+            {
+                const std::string_view previous(names + entries[i - 1].name_offset, entries[i - 1].name_length);
+                if (previous >= std::string_view(names + entry.name_offset, entry.name_length))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    /*
+     *     .
+     *          (),
+     *         .
+     */
+    bool open_archive(const std::string& path)
+    {
+        close_archive();
+
+        MappedFile file;
+        if (map_file(path, file) == false)
+            return false;
+
+        if (validate_archive(file) == false)
+        {
+            std::cerr << "Invalid resource archive " << path << "." << std::endl;
+            unmap_file(file);
+            return false;
+        }
+
+        prefetch_file(file);
+
+        const auto* header = reinterpret_cast<const ArchiveHeader*>(file.data);
+        g_archive = file;
+        g_entries = reinterpret_cast<const ArchiveEntry*>(header + 1);
+        g_entry_count = header->entry_count;
+        g_names = reinterpret_cast<const char*>(file.data + header->names_offset);
+        return true;
+    }
+
+    /*
+     *   .        .
+     */
+    void close_archive(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_inflated_mutex);
+            g_inflated.clear();
+        }
+        if (g_archive.data != nullptr)
+            unmap_file(g_archive);
+
+        g_entries = nullptr;
+        g_entry_count = 0;
+        g_names = nullptr;
+    }
+
+    /*
+     *      .
+     */
+    static const ArchiveEntry* find_entry(std::string_view name)
+    {
+        const ArchiveEntry* end = g_entries + g_entry_count;
+        const ArchiveEntry* entry = std::lower_bound(g_entries, end, name,
+            [](const ArchiveEntry& a, std::string_view b) { return entry_name(a) < b; });
+
+        if (entry == end || entry_name(*entry) != name)
+            return nullptr;
+        return entry;
+    }
+
+    /*
+     *       ( "resources/shaders/tex_v.glsl").
+     *         ,  
+     *        .
+     *          close_archive().
+     */
+    bool open_resource(const std::string& path, Resource& resource)
+    {
+        resource = Resource();
+
+        const std::string name = std::filesystem::path(path).lexically_normal().generic_string();
+        if (find_embedded(name, resource.data))
+            return true;
+
+        if (g_entries != nullptr)
+        {
+            const ArchiveEntry* entry = find_entry(name);
+            if (entry != nullptr)
+            {
+                const unsigned char* data = g_archive.data + entry->offset;
+                if (entry->compression == ARCHIVE_STORED)
+                {
+                    resource.data = std::span<const unsigned char>(data, entry->size);
+                    return true;
+                }
+
+                const uint32_t index = static_cast<uint32_t>(entry - g_entries);
+
+                std::lock_guard<std::mutex> lock(g_inflated_mutex);
+                std::unique_ptr<unsigned char[]>& inflated = g_inflated[index];
+                if (inflated == nullptr)
+                {
+                    std::unique_ptr<unsigned char[]> buffer(new (std::nothrow) unsigned char[entry->original_size]);
+                    if (buffer == nullptr || inflate_zlib(data, entry->size, buffer.get(), entry->original_size) == false)
+                    {
+                        std::cerr << "Failed to decompress " << name << "." << std::endl;
+                        g_inflated.erase(index);
+                        return false;
+                    }
+                    inflated = std::move(buffer);
+                }
+
+                resource.data = std::span<const unsigned char>(inflated.get(), entry->original_size);
+                return true;
+            }
+        }
+
+        if (map_file(path, resource.file) == false)
+            return false;
+
+        resource.data = std::span<const unsigned char>(resource.file.data, resource.file.size);
+        return true;
+    }
+
+    /*
+     *   .         .
+     */
+    void close_resource(Resource& resource)
+    {
+        if (resource.file.data != nullptr)
+            unmap_file(resource.file);
+
+        resource = Resource();
+    }
+
+} // namespace cg
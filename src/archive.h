@@ -0,0 +1,29 @@
+#ifndef CG_ARCHIVE
+#define CG_ARCHIVE
+
+#include "mapped_file.h"
+
+#include <span>
+#include <string>
+
+namespace cg
+{
+
+/*
+ * ,    ,       .
+ * data     -   ,       .
+ */
+struct Resource
+{
+    std::span<const unsigned char> data;    //   
+    MappedFile file;                        //    (     )
+};
+
+bool open_archive(const std::string& path);
+void close_archive(void);
+bool open_resource(const std::string& path, Resource& resource);
+void close_resource(Resource& resource);
+
+} // namespace cg
+
+#endif
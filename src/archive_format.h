@@ -0,0 +1,59 @@
+#ifndef CG_ARCHIVE_FORMAT
+#define CG_ARCHIVE_FORMAT
+
+#include <cstdint>
+
+/*
+ *      (.cgpak).
+ *     tools/respack   resources   
+ *     .      .
+ *
+ * :
+ *   ArchiveHeader
+ *   ArchiveEntry[entry_count]      -    ( )
+ *    (  )
+ *     ,    archive_alignment 
+ */
+namespace cg
+{
+
+constexpr char archive_magic[4] = { 'C', 'G', 'P', 'K' };
+constexpr uint32_t archive_version = 1;
+constexpr uint32_t archive_alignment = 64;
+
+/*
+ *   .
+ */
+enum ArchiveCompression : uint32_t
+{
+    ARCHIVE_STORED = 0,     //   -     
+    ARCHIVE_ZLIB = 1,       // zlib ,     
+};
+
+struct ArchiveHeader
+{
+    char magic[4];          // "CGPK"
+    uint32_t version;       // archive_version
+    uint32_t entry_count;   //  
+    uint32_t names_size;    //     
+    uint64_t names_offset;  //         
+    uint64_t reserved;
+};
+
+struct ArchiveEntry
+{
+    uint64_t offset;        //       
+    uint64_t size;          //     
+    uint64_t original_size; //   
+    uint32_t name_offset;   //       
+    uint32_t name_length;   //   
+    uint32_t compression;   // ArchiveCompression
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ArchiveHeader) == 32, "Unexpected header size");
+static_assert(sizeof(ArchiveEntry) == 40, "Unexpected entry size");
+
+} // namespace cg
+
+#endif
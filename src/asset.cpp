@@ -0,0 +1,123 @@
+#include "asset.h"
+#include "shader.h"
+#include "texture.h"
+
+#include <filesystem>
+#include <unordered_map>
+
+namespace cg
+{
+    /*
+     *       ,      .
+     *      ,     .
+     */
+    static std::unordered_map<std::string, Asset<bool>> g_sources;
+    static std::unordered_map<std::string, Asset<int>> g_programs;
+    static std::unordered_map<std::string, Asset<int>> g_textures;
+
+    static std::string normalize_path(const std::string& path)
+    {
+        return std::filesystem::path(path).lexically_normal().generic_string();
+    }
+
+    /*
+     *         .
+     */
+    static Asset<bool> read_shader_source(std::string path)
+    {
+        co_await resume_on_worker();
+        co_return preload_shader(path);
+    }
+
+    /*
+     *    ,     ( preload_shader()).
+     *  ,   ,     .
+     */
+    Asset<bool> load_shader_source(std::string path)
+    {
+        const std::string key = normalize_path(path);
+        auto it = g_sources.find(key);
+        if (it != g_sources.end())
+            return it->second;
+
+        Asset<bool> source = read_shader_source(key);
+        g_sources.emplace(key, source);
+        return source;
+    }
+
+    /*
+     *  ,      ,
+     *       .
+     *     get_program()  -1  .
+     */
+    static Asset<int> build_program(std::string vertex_path, std::string fragment_path, unsigned int variant)
+    {
+        Asset<bool> vertex_source = load_shader_source(vertex_path);
+        Asset<bool> fragment_source = load_shader_source(fragment_path);
+        const bool has_vertex = co_await vertex_source;
+        const bool has_fragment = co_await fragment_source;
+        if (has_vertex == false || has_fragment == false)
+            co_return -1;
+
+        co_await resume_on_render_thread();
+        const int id = get_program_variant(vertex_path, fragment_path, variant);
+
+        //      -    
+        while (is_program_pending(id))
+            co_await resume_on_render_thread();
+
+        co_return get_program(id) != 0 ? id : -1;
+    }
+
+    Asset<int> load_program_async(std::string vertex_path, std::string fragment_path, unsigned int variant)
+    {
+        const std::string key = normalize_path(vertex_path) + "|" + normalize_path(fragment_path) + "|" +
+            std::to_string(variant);
+        auto it = g_programs.find(key);
+        if (it != g_programs.end())
+            return it->second;
+
+        Asset<int> program = build_program(vertex_path, fragment_path, variant);
+        g_programs.emplace(key, program);
+        return program;
+    }
+
+    /*
+     * ,     .
+     *          ( load_texture()),
+     *     ,      .
+     *       -   .
+     */
+    static Asset<int> stream_texture(std::string path)
+    {
+        co_await resume_on_render_thread();
+        const int id = load_texture(path);
+
+        while (is_texture_ready(id) == false && is_texture_failed(id) == false)
+            co_await resume_on_render_thread();
+
+        co_return id;
+    }
+
+    Asset<int> load_texture_async(std::string path)
+    {
+        auto it = g_textures.find(path);
+        if (it != g_textures.end())
+            return it->second;
+
+        Asset<int> texture = stream_texture(path);
+        g_textures.emplace(path, texture);
+        return texture;
+    }
+
+    /*
+     *   . ,   ,    cleanup_async().
+     */
+    void cleanup_assets(void)
+    {
+        g_sources.clear();
+        g_programs.clear();
+        g_textures.clear();
+    }
+
+} // namespace cg
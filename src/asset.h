@@ -0,0 +1,18 @@
+#ifndef CG_ASSET
+#define CG_ASSET
+
+#include "async.h"
+
+#include <string>
+
+namespace cg
+{
+
+Asset<bool> load_shader_source(std::string path);
+Asset<int> load_program_async(std::string vertex_path, std::string fragment_path, unsigned int variant);
+Asset<int> load_texture_async(std::string path);
+void cleanup_assets(void);
+
+} // namespace cg
+
+#endif
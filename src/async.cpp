@@ -0,0 +1,122 @@
+#include "async.h"
+#include "redraw.h"
+#include "thread_pool.h"
+
+namespace cg
+{
+    /*
+     * ,    .
+     */
+    static std::mutex g_render_mutex;
+    static std::vector<std::coroutine_handle<>> g_render_queue;
+
+    /*
+     * ,     .     -
+     *  ,     (  ).
+     */
+    static std::mutex g_states_mutex;
+    static std::vector<std::weak_ptr<AssetStateBase>> g_waited_states;
+
+    /*
+     *     (  )
+     *       .
+     */
+    void ResumeOn::await_suspend(std::coroutine_handle<> handle) const
+    {
+        if (render_thread == false)
+        {
+            submit_task([handle] { handle.resume(); });
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(g_render_mutex);
+            g_render_queue.push_back(handle);
+        }
+        request_redraw();   // update_async()     
+    }
+
+    ResumeOn resume_on_worker(void)
+    {
+        return ResumeOn{ false };
+    }
+
+    /*
+     *       update_async().
+     *    "   "      ,
+     *     .
+     */
+    ResumeOn resume_on_render_thread(void)
+    {
+        return ResumeOn{ true };
+    }
+
+    /*
+     *       .
+     * ,       ,    .
+     */
+    void update_async(void)
+    {
+        std::vector<std::coroutine_handle<>> queue;
+        {
+            std::lock_guard<std::mutex> lock(g_render_mutex);
+            queue.swap(g_render_queue);
+        }
+
+        for (std::coroutine_handle<> handle : queue)
+            handle.resume();
+    }
+
+    /*
+     *   ,       ( Asset::await_suspend()).
+     */
+    void track_asset_waiters(const std::shared_ptr<AssetStateBase>& state)
+    {
+        std::lock_guard<std::mutex> lock(g_states_mutex);
+        for (const std::weak_ptr<AssetStateBase>& tracked : g_waited_states)
+        {
+            if (tracked.lock() == state)
+                return;
+        }
+
+        std::erase_if(g_waited_states, [](const std::weak_ptr<AssetStateBase>& tracked) { return tracked.expired(); });
+        g_waited_states.push_back(state);
+    }
+
+    /*
+     *   ,        .
+     *         ,     
+     *      -      .
+     *        .
+     */
+    void cleanup_async(void)
+    {
+        std::vector<std::coroutine_handle<>> handles;
+        {
+            std::lock_guard<std::mutex> lock(g_render_mutex);
+            handles.swap(g_render_queue);
+        }
+
+        std::vector<std::shared_ptr<AssetStateBase>> states;
+        {
+            std::lock_guard<std::mutex> lock(g_states_mutex);
+            for (const std::weak_ptr<AssetStateBase>& tracked : g_waited_states)
+            {
+                if (std::shared_ptr<AssetStateBase> state = tracked.lock())
+                    states.push_back(std::move(state));
+            }
+            g_waited_states.clear();
+        }
+
+        for (const std::shared_ptr<AssetStateBase>& state : states)
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            handles.insert(handles.end(), state->waiters.begin(), state->waiters.end());
+            state->waiters.clear();
+        }
+
+        for (std::coroutine_handle<> handle : handles)
+            handle.destroy();
+    }
+
+} // namespace cg
@@ -0,0 +1,149 @@
+#ifndef CG_ASYNC
+#define CG_ASYNC
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cg
+{
+
+/*
+ *      ,        -
+ *   cleanup_async()  ,   .
+ */
+struct AssetStateBase
+{
+    std::mutex mutex;
+    bool done = false;
+    std::vector<std::coroutine_handle<>> waiters;
+};
+
+void track_asset_waiters(const std::shared_ptr<AssetStateBase>& state);
+
+/*
+ *      -   ,   .
+ */
+template <typename T>
+struct AssetState : AssetStateBase
+{
+    T value{};
+
+    /*
+     *           .
+     */
+    void set(T result)
+    {
+        std::vector<std::coroutine_handle<>> resumed;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            value = std::move(result);
+            done = true;
+            resumed.swap(waiters);
+        }
+
+        for (std::coroutine_handle<> waiter : resumed)
+            waiter.resume();
+    }
+};
+
+/*
+ *   -    (C++20).
+ *          ,  ,
+ *      .       co_await
+ *     -   ,     .
+ *     OpenGL        
+ *  co_await resume_on_render_thread().
+ *
+ *         - 
+ *       .
+ */
+template <typename T>
+class Asset
+{
+public:
+    struct promise_type
+    {
+        std::shared_ptr<AssetState<T>> state = std::make_shared<AssetState<T>>();
+
+        Asset get_return_object() { return Asset(state); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_value(T value) { state->set(std::move(value)); }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    Asset(void) = default;
+    explicit Asset(std::shared_ptr<AssetState<T>> state) : state(std::move(state)) {}
+
+    /*
+     *    (    ).
+     */
+    bool is_ready(void) const
+    {
+        if (state == nullptr)
+            return false;
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+        return state->done;
+    }
+
+    /*
+     *    .
+     */
+    const T& get(void) const
+    {
+        return state->value;
+    }
+
+    /*
+     * Awaitable .
+     */
+    bool await_ready(void) const
+    {
+        return is_ready();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) const
+    {
+        track_asset_waiters(state);
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->done)
+            return false;   //     -  
+
+        state->waiters.push_back(handle);
+        return true;
+    }
+
+    const T& await_resume(void) const
+    {
+        return state->value;
+    }
+
+private:
+    std::shared_ptr<AssetState<T>> state;
+};
+
+/*
+ *      .
+ */
+struct ResumeOn
+{
+    bool render_thread;     // true -  (GL) , false -    
+
+    bool await_ready(void) const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) const;
+    void await_resume(void) const noexcept {}
+};
+
+ResumeOn resume_on_worker(void);
+ResumeOn resume_on_render_thread(void);
+void update_async(void);
+void cleanup_async(void);
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,78 @@
+#include "command_list.h"
+#include "texture.h"
+
+namespace cg
+{
+    static_assert(sizeof(DrawInstance) == 80, "DrawInstance must match the std430 layout in tex_v.glsl");
+    static_assert(sizeof(DrawPacket) == 24, "DrawPacket should stay compact");
+
+    /*
+     *   .      .
+     */
+    void clear_command_list(CommandList& list)
+    {
+        list.packets.clear();
+        list.instances.clear();
+        list.lights.clear();
+        list.texture_uses.clear();
+    }
+
+    /*
+     *      .
+     */
+    void record_draw(CommandList& list, uint64_t key, unsigned int mesh, const DrawInstance& instance)
+    {
+        list.packets.push_back({ key, mesh, instance.material, static_cast<uint32_t>(list.instances.size()), 1 });
+        list.instances.push_back(instance);
+    }
+
+    /*
+     *         (  ).
+     *            .
+     *    .
+     */
+    void merge_command_lists(std::vector<CommandList>& lists, CommandList& merged)
+    {
+        clear_command_list(merged);
+
+        size_t packets = 0, instances = 0, lights = 0, texture_uses = 0;
+        for (const CommandList& list : lists)
+        {
+            packets += list.packets.size();
+            instances += list.instances.size();
+            lights += list.lights.size();
+            texture_uses += list.texture_uses.size();
+        }
+        merged.packets.reserve(packets);
+        merged.instances.reserve(instances);
+        merged.lights.reserve(lights);
+        merged.texture_uses.reserve(texture_uses);
+
+        for (CommandList& list : lists)
+        {
+            const uint32_t offset = static_cast<uint32_t>(merged.instances.size());
+            for (DrawPacket packet : list.packets)
+            {
+                packet.first_instance += offset;
+                merged.packets.push_back(packet);
+            }
+            merged.instances.insert(merged.instances.end(), list.instances.begin(), list.instances.end());
+            merged.lights.insert(merged.lights.end(), list.lights.begin(), list.lights.end());
+            merged.texture_uses.insert(merged.texture_uses.end(), list.texture_uses.begin(), list.texture_uses.end());
+            clear_command_list(list);
+        }
+    }
+
+    /*
+     *         .
+     *        ,      .
+     */
+    void submit_command_list_state(const CommandList& list)
+    {
+        for (const PointLight& light : list.lights)
+            add_light(light);
+        for (const TextureUse& use : list.texture_uses)
+            mark_texture_used(use.texture, use.screen_size);
+    }
+
+} // namespace cg
@@ -0,0 +1,66 @@
+#ifndef CG_COMMAND_LIST
+#define CG_COMMAND_LIST
+
+#include "lighting.h"
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace cg
+{
+
+/*
+ *      SSBO.
+ *    struct Instance  tex_v.glsl (std430, 80 ).
+ */
+struct DrawInstance
+{
+    glm::mat4 model;
+    unsigned int material;
+    unsigned int padding[3];
+};
+
+/*
+ *    (24 ):   , , 
+ *      ,    .
+ */
+struct DrawPacket
+{
+    uint64_t key;                   //   make_sort_key()
+    uint32_t mesh;                  // 
+    uint32_t material;              //     
+    uint32_t first_instance;        //    CommandList::instances
+    uint32_t instance_count;        //  
+};
+
+/*
+ *      (   ,  mark_texture_used()).
+ */
+struct TextureUse
+{
+    int texture;
+    float screen_size;
+};
+
+/*
+ *       .
+ *    OpenGL -   ,       .
+ *       .
+ */
+struct CommandList
+{
+    std::vector<DrawPacket> packets;
+    std::vector<DrawInstance> instances;
+    std::vector<PointLight> lights;
+    std::vector<TextureUse> texture_uses;
+};
+
+void clear_command_list(CommandList& list);
+void record_draw(CommandList& list, uint64_t key, unsigned int mesh, const DrawInstance& instance);
+void merge_command_lists(std::vector<CommandList>& lists, CommandList& merged);
+void submit_command_list_state(const CommandList& list);
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,37 @@
+#include "embedded.h"
+
+#include <algorithm>
+
+namespace cg
+{
+#ifdef CG_EMBED_RESOURCES
+    //   tools/embed_resources.cmake
+    extern const EmbeddedResource g_embedded_resources[];
+    extern const size_t g_embedded_resource_count;
+
+    /*
+     *        .
+     */
+    bool find_embedded(std::string_view name, std::span<const unsigned char>& data)
+    {
+        const EmbeddedResource* end = g_embedded_resources + g_embedded_resource_count;
+        const EmbeddedResource* resource = std::lower_bound(g_embedded_resources, end, name,
+            [](const EmbeddedResource& a, std::string_view b) { return std::string_view(a.name) < b; });
+
+        if (resource == end || name != resource->name)
+            return false;
+
+        data = std::span<const unsigned char>(resource->data, resource->size);
+        return true;
+    }
+#else
+    /*
+     *           .
+     */
+    bool find_embedded(std::string_view, std::span<const unsigned char>&)
+    {
+        return false;
+    }
+#endif
+
+} // namespace cg
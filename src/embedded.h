@@ -0,0 +1,26 @@
+#ifndef CG_EMBEDDED
+#define CG_EMBEDDED
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace cg
+{
+
+/*
+ * ,       ( EMBED_RESOURCES).
+ *     tools/embed_resources.cmake,   .
+ */
+struct EmbeddedResource
+{
+    const char* name;               // ,  "resources/shaders/tex_v.glsl"
+    const unsigned char* data;      //  (   )
+    size_t size;                    //    
+};
+
+bool find_embedded(std::string_view name, std::span<const unsigned char>& data);
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,58 @@
+#include "glad/glad.h"
+#include <GLFW/glfw3.h>
+
+#include "gl_ext.h"
+
+#include <string>
+#include <unordered_set>
+
+namespace cg
+{
+    PFN_glMaxShaderCompilerThreadsKHR glMaxShaderCompilerThreadsKHR = nullptr;
+    PFN_glGetTextureHandleARB glGetTextureHandleARB = nullptr;
+    PFN_glMakeTextureHandleResidentARB glMakeTextureHandleResidentARB = nullptr;
+    PFN_glMakeTextureHandleNonResidentARB glMakeTextureHandleNonResidentARB = nullptr;
+
+    static std::unordered_set<std::string> g_extensions;   //    
+
+    /*
+     *           .
+     *      gladLoadGL(),    .
+     */
+    void init_gl_extensions(void)
+    {
+        int count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (int i = 0; i < count; i++)
+        {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (name != nullptr)
+                g_extensions.insert(name);
+        }
+
+        if (has_gl_extension("GL_KHR_parallel_shader_compile"))
+        {
+            glMaxShaderCompilerThreadsKHR = reinterpret_cast<PFN_glMaxShaderCompilerThreadsKHR>(
+                glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+        }
+
+        if (has_gl_extension("GL_ARB_bindless_texture"))
+        {
+            glGetTextureHandleARB = reinterpret_cast<PFN_glGetTextureHandleARB>(
+                glfwGetProcAddress("glGetTextureHandleARB"));
+            glMakeTextureHandleResidentARB = reinterpret_cast<PFN_glMakeTextureHandleResidentARB>(
+                glfwGetProcAddress("glMakeTextureHandleResidentARB"));
+            glMakeTextureHandleNonResidentARB = reinterpret_cast<PFN_glMakeTextureHandleNonResidentARB>(
+                glfwGetProcAddress("glMakeTextureHandleNonResidentARB"));
+        }
+    }
+
+    /*
+     *      .
+     */
+    bool has_gl_extension(const char* name)
+    {
+        return g_extensions.find(name) != g_extensions.end();
+    }
+
+} // namespace cg
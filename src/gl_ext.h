@@ -0,0 +1,64 @@
+#ifndef CG_GL_EXT
+#define CG_GL_EXT
+
+/*
+ *   OpenGL,       GLAD.
+ *        ,
+ *       Premake,   CMake   GLAD.
+ */
+
+#include "glad/glad.h"
+
+#include <cstdint>
+
+/*
+ *       OpenGL (__stdcall  32- Windows),
+ *    GLAD   .
+ */
+#ifndef APIENTRY
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#define APIENTRY __stdcall
+#else
+#define APIENTRY
+#endif
+#endif
+
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace cg
+{
+
+typedef void (APIENTRY *PFN_glMaxShaderCompilerThreadsKHR)(unsigned int count);
+typedef uint64_t (APIENTRY *PFN_glGetTextureHandleARB)(unsigned int texture);
+typedef void (APIENTRY *PFN_glMakeTextureHandleResidentARB)(uint64_t handle);
+typedef void (APIENTRY *PFN_glMakeTextureHandleNonResidentARB)(uint64_t handle);
+
+/*
+ *     .
+ *   nullptr,     .
+ */
+extern PFN_glMaxShaderCompilerThreadsKHR glMaxShaderCompilerThreadsKHR;
+extern PFN_glGetTextureHandleARB glGetTextureHandleARB;
+extern PFN_glMakeTextureHandleResidentARB glMakeTextureHandleResidentARB;
+extern PFN_glMakeTextureHandleNonResidentARB glMakeTextureHandleNonResidentARB;
+
+void init_gl_extensions(void);
+bool has_gl_extension(const char* name);
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,119 @@
+#include "glad/glad.h"
+
+#include "gl_resource.h"
+
+namespace cg
+{
+    GlBuffer::GlBuffer(size_t size, const void* data, unsigned int flags)
+    {
+        glCreateBuffers(1, &handle);
+        glNamedBufferStorage(handle, static_cast<GLsizeiptr>(size), data, flags);
+    }
+
+    /*
+     *         CPU.
+     *  GL_MAP_PERSISTENT_BIT       .
+     */
+    void* GlBuffer::map(size_t offset, size_t size, unsigned int access)
+    {
+        return glMapNamedBufferRange(handle, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), access);
+    }
+
+    /*
+     *       CPU (  GL_DYNAMIC_STORAGE_BIT).
+     */
+    void GlBuffer::update(size_t offset, size_t size, const void* data)
+    {
+        glNamedBufferSubData(handle, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    }
+
+    /*
+     *    size   source     ( GPU).
+     */
+    void GlBuffer::copy_from(const GlBuffer& source, size_t size)
+    {
+        glCopyNamedBufferSubData(source.id(), handle, 0, 0, static_cast<GLsizeiptr>(size));
+    }
+
+    /*
+     *     32-  (     ).
+     */
+    void GlBuffer::clear_uint(unsigned int value)
+    {
+        glClearNamedBufferData(handle, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &value);
+    }
+
+    GlTexture::GlTexture(unsigned int target, int levels, unsigned int internal_format, int width, int height, int depth)
+    {
+        glCreateTextures(target, 1, &handle);
+        if (target == GL_TEXTURE_2D_ARRAY)
+            glTextureStorage3D(handle, levels, internal_format, width, height, depth);
+        else
+            glTextureStorage2D(handle, levels, internal_format, width, height);
+    }
+
+    /*
+     *   .  bindless        handle.
+     */
+    void GlTexture::set_sampling(unsigned int min_filter, unsigned int mag_filter, unsigned int wrap)
+    {
+        glTextureParameteri(handle, GL_TEXTURE_MIN_FILTER, min_filter);
+        glTextureParameteri(handle, GL_TEXTURE_MAG_FILTER, mag_filter);
+        glTextureParameteri(handle, GL_TEXTURE_WRAP_S, wrap);
+        glTextureParameteri(handle, GL_TEXTURE_WRAP_T, wrap);
+    }
+
+    GlRenderbuffer::GlRenderbuffer(int samples, unsigned int internal_format, int width, int height)
+    {
+        glCreateRenderbuffers(1, &handle);
+        glNamedRenderbufferStorageMultisample(handle, samples, internal_format, width, height);
+    }
+
+    /*
+     *    -      .
+     */
+    int GlRenderbuffer::get_samples(void) const
+    {
+        int samples = 0;
+        glGetNamedRenderbufferParameteriv(handle, GL_RENDERBUFFER_SAMPLES, &samples);
+        return samples;
+    }
+
+    GlFramebuffer GlFramebuffer::create(void)
+    {
+        GlFramebuffer framebuffer;
+        glCreateFramebuffers(1, &framebuffer.handle);
+        return framebuffer;
+    }
+
+    void GlFramebuffer::attach(unsigned int attachment, const GlTexture& texture, int level)
+    {
+        glNamedFramebufferTexture(handle, attachment, texture.id(), level);
+    }
+
+    void GlFramebuffer::attach(unsigned int attachment, const GlRenderbuffer& renderbuffer)
+    {
+        glNamedFramebufferRenderbuffer(handle, attachment, GL_RENDERBUFFER, renderbuffer.id());
+    }
+
+    bool GlFramebuffer::is_complete(void) const
+    {
+        return glCheckNamedFramebufferStatus(handle, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    GlVertexArray GlVertexArray::create(void)
+    {
+        GlVertexArray vao;
+        glCreateVertexArrays(1, &vao.handle);
+        return vao;
+    }
+
+    /*
+     *     glDraw*Elements*() -     VAO.
+     */
+    void GlVertexArray::set_element_buffer(const GlBuffer& buffer)
+    {
+        glVertexArrayElementBuffer(handle, buffer.id());
+    }
+
+} // namespace cg
@@ -0,0 +1,123 @@
+#ifndef CG_GL_RESOURCE
+#define CG_GL_RESOURCE
+
+#include "gl_state.h"
+
+#include <cstddef>
+#include <utility>
+
+namespace cg
+{
+
+/*
+ *   OpenGL   Direct State Access (OpenGL 4.5).
+ *     glCreate*     ,    ,
+ *           .   
+ *     (glNamedBufferStorage, glTextureStorage*) - 
+ *         .
+ *
+ *        gl_state.h,     
+ *  .        reset() 
+ *    ( cleanup_*   ).
+ */
+template <void (*Delete)(unsigned int)>
+class GlObject
+{
+public:
+    GlObject(void) = default;
+    explicit GlObject(unsigned int handle) : handle(handle) {}
+    ~GlObject(void) { reset(); }
+
+    GlObject(const GlObject&) = delete;
+    GlObject& operator=(const GlObject&) = delete;
+    GlObject(GlObject&& other) noexcept : handle(std::exchange(other.handle, 0)) {}
+    GlObject& operator=(GlObject&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            handle = std::exchange(other.handle, 0);
+        }
+        return *this;
+    }
+
+    unsigned int id(void) const { return handle; }
+    explicit operator bool(void) const { return handle != 0; }
+
+    void reset(void)
+    {
+        if (handle != 0)
+            Delete(handle);
+        handle = 0;
+    }
+
+protected:
+    unsigned int handle = 0;
+};
+
+/*
+ *    .
+ * flags   glBufferStorage (GL_DYNAMIC_STORAGE_BIT, GL_MAP_WRITE_BIT, GL_MAP_PERSISTENT_BIT...).
+ *          GPU (glCopyNamedBufferSubData, ).
+ */
+class GlBuffer : public GlObject<delete_buffer>
+{
+public:
+    GlBuffer(void) = default;
+    GlBuffer(size_t size, const void* data, unsigned int flags);
+
+    void* map(size_t offset, size_t size, unsigned int access);
+    void update(size_t offset, size_t size, const void* data);
+    void copy_from(const GlBuffer& source, size_t size);
+    void clear_uint(unsigned int value);
+};
+
+/*
+ *    : GL_TEXTURE_2D (depth = 1)  GL_TEXTURE_2D_ARRAY.
+ */
+class GlTexture : public GlObject<delete_texture>
+{
+public:
+    GlTexture(void) = default;
+    GlTexture(unsigned int target, int levels, unsigned int internal_format, int width, int height, int depth = 1);
+
+    void set_sampling(unsigned int min_filter, unsigned int mag_filter, unsigned int wrap);
+};
+
+/*
+ * Renderbuffer (samples = 0 -   ).
+ */
+class GlRenderbuffer : public GlObject<delete_renderbuffer>
+{
+public:
+    GlRenderbuffer(void) = default;
+    GlRenderbuffer(int samples, unsigned int internal_format, int width, int height);
+
+    int get_samples(void) const;
+};
+
+class GlFramebuffer : public GlObject<delete_framebuffer>
+{
+public:
+    static GlFramebuffer create(void);
+
+    void attach(unsigned int attachment, const GlTexture& texture, int level = 0);
+    void attach(unsigned int attachment, const GlRenderbuffer& renderbuffer);
+    bool is_complete(void) const;
+};
+
+/*
+ * VAO   -      ( mesh.cpp),
+ *  VAO     .
+ */
+class GlVertexArray : public GlObject<delete_vertex_array>
+{
+public:
+    static GlVertexArray create(void);
+
+    void set_element_buffer(const GlBuffer& buffer);
+};
+
+} // namespace cg
+
+#endif
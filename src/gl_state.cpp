@@ -0,0 +1,432 @@
+#include "glad/glad.h"
+
+#include "gl_state.h"
+
+namespace cg
+{
+    /*
+     *   OpenGL .
+     *          ,  
+     *   .   OpenGL (llvmpipe)       CPU.
+     *
+     *   ,        .
+     * ,    ,    .
+     * ImGui     ,    .
+     */
+    constexpr unsigned int unknown = 0xFFFFFFFFu;      //      
+    constexpr int max_texture_units = 16;
+    constexpr int max_indexed_bindings = 16;
+
+    enum BufferSlot
+    {
+        BUFFER_ARRAY,
+        BUFFER_PIXEL_UNPACK,
+        BUFFER_PIXEL_PACK,
+        BUFFER_COPY_READ,
+        BUFFER_COPY_WRITE,
+        BUFFER_DRAW_INDIRECT,
+        BUFFER_UNIFORM,             //    
+        BUFFER_SHADER_STORAGE,
+        BUFFER_SLOT_COUNT,
+        BUFFER_INDEXED_FIRST = BUFFER_UNIFORM
+    };
+
+    enum TextureSlot
+    {
+        TEXTURE_2D,
+        TEXTURE_2D_ARRAY,
+        TEXTURE_CUBE_MAP,
+        TEXTURE_SLOT_COUNT
+    };
+
+    enum CapabilitySlot
+    {
+        CAPABILITY_BLEND,
+        CAPABILITY_DEPTH_TEST,
+        CAPABILITY_CULL_FACE,
+        CAPABILITY_MULTISAMPLE,
+        CAPABILITY_SCISSOR_TEST,
+        CAPABILITY_COUNT
+    };
+
+    struct GlState
+    {
+        unsigned int program;
+        unsigned int vao;
+        unsigned int draw_framebuffer;
+        unsigned int read_framebuffer;
+        unsigned int active_unit;
+        unsigned int buffers[BUFFER_SLOT_COUNT];
+        unsigned int indexed[BUFFER_SLOT_COUNT - BUFFER_INDEXED_FIRST][max_indexed_bindings];
+        unsigned int textures[max_texture_units][TEXTURE_SLOT_COUNT];
+        unsigned int capabilities[CAPABILITY_COUNT];
+        unsigned int depth_mask;
+        unsigned int blend_source;
+        unsigned int blend_destination;
+        int viewport[4];
+    };
+
+    static GlState unknown_state(void)
+    {
+        GlState state;
+        state.program = unknown;
+        state.vao = unknown;
+        state.draw_framebuffer = unknown;
+        state.read_framebuffer = unknown;
+        state.active_unit = unknown;
+        for (unsigned int& buffer : state.buffers)
+            buffer = unknown;
+        for (auto& bindings : state.indexed)
+            for (unsigned int& buffer : bindings)
+                buffer = unknown;
+        for (auto& unit : state.textures)
+            for (unsigned int& texture : unit)
+                texture = unknown;
+        for (unsigned int& capability : state.capabilities)
+            capability = unknown;
+        state.depth_mask = unknown;
+        state.blend_source = unknown;
+        state.blend_destination = unknown;
+        state.viewport[0] = state.viewport[1] = state.viewport[2] = state.viewport[3] = -1;
+        return state;
+    }
+
+    static GlState g_state = unknown_state();
+
+#ifdef CG_GL_STATE_STATS
+    static GlStateStats g_frame_stats = {};     //  
+    static GlStateStats g_last_stats = {};      //   
+
+    static void count_call(bool skipped)
+    {
+        g_frame_stats.calls++;
+        if (skipped)
+            g_frame_stats.skipped++;
+    }
+#else
+    static void count_call(bool)
+    {
+    }
+#endif
+
+    /*
+     *      .
+     *  false,           .
+     */
+    static bool update(unsigned int& cached, unsigned int value)
+    {
+        const bool skipped = cached == value;
+        count_call(skipped);
+        cached = value;
+        return skipped == false;
+    }
+
+    static int buffer_slot(unsigned int target)
+    {
+        switch (target)
+        {
+        case GL_ARRAY_BUFFER: return BUFFER_ARRAY;
+        case GL_PIXEL_UNPACK_BUFFER: return BUFFER_PIXEL_UNPACK;
+        case GL_PIXEL_PACK_BUFFER: return BUFFER_PIXEL_PACK;
+        case GL_COPY_READ_BUFFER: return BUFFER_COPY_READ;
+        case GL_COPY_WRITE_BUFFER: return BUFFER_COPY_WRITE;
+        case GL_DRAW_INDIRECT_BUFFER: return BUFFER_DRAW_INDIRECT;
+        case GL_UNIFORM_BUFFER: return BUFFER_UNIFORM;
+        case GL_SHADER_STORAGE_BUFFER: return BUFFER_SHADER_STORAGE;
+        default: return -1;     //  GL_ELEMENT_ARRAY_BUFFER -     VAO
+        }
+    }
+
+    static int texture_slot(unsigned int target)
+    {
+        switch (target)
+        {
+        case GL_TEXTURE_2D: return TEXTURE_2D;
+        case GL_TEXTURE_2D_ARRAY: return TEXTURE_2D_ARRAY;
+        case GL_TEXTURE_CUBE_MAP: return TEXTURE_CUBE_MAP;
+        default: return -1;
+        }
+    }
+
+    static int capability_slot(unsigned int capability)
+    {
+        switch (capability)
+        {
+        case GL_BLEND: return CAPABILITY_BLEND;
+        case GL_DEPTH_TEST: return CAPABILITY_DEPTH_TEST;
+        case GL_CULL_FACE: return CAPABILITY_CULL_FACE;
+        case GL_MULTISAMPLE: return CAPABILITY_MULTISAMPLE;
+        case GL_SCISSOR_TEST: return CAPABILITY_SCISSOR_TEST;
+        default: return -1;
+        }
+    }
+
+    void bind_program(unsigned int program)
+    {
+        if (update(g_state.program, program))
+            glUseProgram(program);
+    }
+
+    void bind_vertex_array(unsigned int vao)
+    {
+        if (update(g_state.vao, vao))
+            glBindVertexArray(vao);
+    }
+
+    /*
+     * GL_FRAMEBUFFER        .
+     */
+    void bind_framebuffer(unsigned int target, unsigned int framebuffer)
+    {
+        if (target == GL_FRAMEBUFFER)
+        {
+            const bool skipped = g_state.draw_framebuffer == framebuffer && g_state.read_framebuffer == framebuffer;
+            count_call(skipped);
+            if (skipped)
+                return;
+
+            glBindFramebuffer(target, framebuffer);
+            g_state.draw_framebuffer = framebuffer;
+            g_state.read_framebuffer = framebuffer;
+            return;
+        }
+
+        unsigned int& cached = target == GL_DRAW_FRAMEBUFFER ? g_state.draw_framebuffer : g_state.read_framebuffer;
+        if (update(cached, framebuffer))
+            glBindFramebuffer(target, framebuffer);
+    }
+
+    void bind_buffer(unsigned int target, unsigned int buffer)
+    {
+        const int slot = buffer_slot(target);
+        if (slot < 0)
+        {
+            count_call(false);
+            glBindBuffer(target, buffer);
+            return;
+        }
+
+        if (update(g_state.buffers[slot], buffer))
+            glBindBuffer(target, buffer);
+    }
+
+    /*
+     *     (UBO, SSBO).
+     * glBindBufferBase        .
+     */
+    void bind_buffer_base(unsigned int target, unsigned int index, unsigned int buffer)
+    {
+        const int slot = buffer_slot(target);
+        if (slot < BUFFER_INDEXED_FIRST || index >= max_indexed_bindings)
+        {
+            count_call(false);
+            glBindBufferBase(target, index, buffer);
+            if (slot >= 0)
+                g_state.buffers[slot] = buffer;
+            return;
+        }
+
+        if (update(g_state.indexed[slot - BUFFER_INDEXED_FIRST][index], buffer))
+        {
+            glBindBufferBase(target, index, buffer);
+            g_state.buffers[slot] = buffer;
+        }
+    }
+
+    /*
+     *     .      ,
+     *     -   ,   bind_buffer_base()
+     *      .
+     */
+    void bind_buffer_range(unsigned int target, unsigned int index, unsigned int buffer, size_t offset, size_t size)
+    {
+        count_call(false);
+        glBindBufferRange(target, index, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+
+        const int slot = buffer_slot(target);
+        if (slot >= 0)
+            g_state.buffers[slot] = buffer;
+        if (slot >= BUFFER_INDEXED_FIRST && index < max_indexed_bindings)
+            g_state.indexed[slot - BUFFER_INDEXED_FIRST][index] = unknown;
+    }
+
+    void bind_texture(unsigned int unit, unsigned int target, unsigned int texture)
+    {
+        const int slot = texture_slot(target);
+        if (slot >= 0 && unit < max_texture_units && g_state.textures[unit][slot] == texture)
+        {
+            count_call(true);
+            return;
+        }
+
+        count_call(false);
+        if (g_state.active_unit != unit)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            g_state.active_unit = unit;
+        }
+        glBindTexture(target, texture);
+        if (slot >= 0 && unit < max_texture_units)
+            g_state.textures[unit][slot] = texture;
+    }
+
+    void set_capability(unsigned int capability, bool enabled)
+    {
+        const int slot = capability_slot(capability);
+        if (slot >= 0 && update(g_state.capabilities[slot], enabled) == false)
+            return;
+        if (slot < 0)
+            count_call(false);
+
+        if (enabled)
+            glEnable(capability);
+        else
+            glDisable(capability);
+    }
+
+    void set_depth_mask(bool enabled)
+    {
+        if (update(g_state.depth_mask, enabled))
+            glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+
+    void set_blend_func(unsigned int source, unsigned int destination)
+    {
+        const bool skipped = g_state.blend_source == source && g_state.blend_destination == destination;
+        count_call(skipped);
+        if (skipped)
+            return;
+
+        glBlendFunc(source, destination);
+        g_state.blend_source = source;
+        g_state.blend_destination = destination;
+    }
+
+    void set_viewport(int x, int y, int width, int height)
+    {
+        int* viewport = g_state.viewport;
+        const bool skipped = viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height;
+        count_call(skipped);
+        if (skipped)
+            return;
+
+        glViewport(x, y, width, height);
+        viewport[0] = x;
+        viewport[1] = y;
+        viewport[2] = width;
+        viewport[3] = height;
+    }
+
+    /*
+     *   .
+     *       ,     
+     *     -       .
+     */
+    void delete_program(unsigned int program)
+    {
+        if (program == 0)
+            return;
+
+        glDeleteProgram(program);
+        if (g_state.program == program)
+            g_state.program = unknown;  //  ,     
+    }
+
+    void delete_vertex_array(unsigned int vao)
+    {
+        if (vao == 0)
+            return;
+
+        glDeleteVertexArrays(1, &vao);
+        if (g_state.vao == vao)
+            g_state.vao = 0;
+    }
+
+    void delete_buffer(unsigned int buffer)
+    {
+        if (buffer == 0)
+            return;
+
+        glDeleteBuffers(1, &buffer);
+        for (unsigned int& bound : g_state.buffers)
+        {
+            if (bound == buffer)
+                bound = 0;
+        }
+        for (auto& bindings : g_state.indexed)
+        {
+            for (unsigned int& bound : bindings)
+            {
+                if (bound == buffer)
+                    bound = unknown;
+            }
+        }
+    }
+
+    /*
+     * Renderbuffer-    ( gl_resource.h) -      .
+     */
+    void delete_renderbuffer(unsigned int renderbuffer)
+    {
+        if (renderbuffer != 0)
+            glDeleteRenderbuffers(1, &renderbuffer);
+    }
+
+    void delete_framebuffer(unsigned int framebuffer)
+    {
+        if (framebuffer == 0)
+            return;
+
+        glDeleteFramebuffers(1, &framebuffer);
+        if (g_state.draw_framebuffer == framebuffer)
+            g_state.draw_framebuffer = 0;
+        if (g_state.read_framebuffer == framebuffer)
+            g_state.read_framebuffer = 0;
+    }
+
+    void delete_texture(unsigned int texture)
+    {
+        if (texture == 0)
+            return;
+
+        glDeleteTextures(1, &texture);
+        for (auto& unit : g_state.textures)
+        {
+            for (unsigned int& bound : unit)
+            {
+                if (bound == texture)
+                    bound = 0;
+            }
+        }
+    }
+
+    /*
+     *    -      get_gl_state_stats().
+     */
+    void finish_gl_state_frame(void)
+    {
+#ifdef CG_GL_STATE_STATS
+        g_last_stats = g_frame_stats;
+        g_frame_stats = {};
+#endif
+    }
+
+    GlStateStats get_gl_state_stats(void)
+    {
+#ifdef CG_GL_STATE_STATS
+        return g_last_stats;
+#else
+        return {};
+#endif
+    }
+
+    bool has_gl_state_stats(void)
+    {
+#ifdef CG_GL_STATE_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+} // namespace cg
@@ -0,0 +1,44 @@
+#ifndef CG_GL_STATE
+#define CG_GL_STATE
+
+#include <cstddef>
+
+namespace cg
+{
+
+/*
+ *       OpenGL    .
+ *     CG_GL_STATE_STATS (  Debug).
+ */
+struct GlStateStats
+{
+    int calls;          //     
+    int skipped;        // ,     
+};
+
+void bind_program(unsigned int program);
+void bind_vertex_array(unsigned int vao);
+void bind_framebuffer(unsigned int target, unsigned int framebuffer);
+void bind_buffer(unsigned int target, unsigned int buffer);
+void bind_buffer_base(unsigned int target, unsigned int index, unsigned int buffer);
+void bind_buffer_range(unsigned int target, unsigned int index, unsigned int buffer, size_t offset, size_t size);
+void bind_texture(unsigned int unit, unsigned int target, unsigned int texture);
+void set_capability(unsigned int capability, bool enabled);
+void set_depth_mask(bool enabled);
+void set_blend_func(unsigned int source, unsigned int destination);
+void set_viewport(int x, int y, int width, int height);
+
+void delete_program(unsigned int program);
+void delete_vertex_array(unsigned int vao);
+void delete_buffer(unsigned int buffer);
+void delete_framebuffer(unsigned int framebuffer);
+void delete_renderbuffer(unsigned int renderbuffer);
+void delete_texture(unsigned int texture);
+
+void finish_gl_state_frame(void);
+GlStateStats get_gl_state_stats(void);
+bool has_gl_state_stats(void);
+
+} // namespace cg
+
+#endif
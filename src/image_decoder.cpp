@@ -0,0 +1,439 @@
+#include "image_decoder.h"
+#include "inflate.h"
+#include "vendor/stb_image.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CG_DECODER_SSE2
+#endif
+
+/*
+ *     RGBA8     
+ * (     PBO,   ).
+ *
+ * PNG  8     interlace      -
+ * inflate (inflate.cpp)  SSE2    .
+ *   (JPEG, 16- PNG, interlace  ..)   stb_image.
+ */
+namespace cg
+{
+    constexpr int max_image_size = 16384;   //  /  
+
+    /*
+     * ---------------------------------------------------------------------
+     *   PNG 
+     * ---------------------------------------------------------------------
+     */
+
+    static inline unsigned char paeth(int a, int b, int c)
+    {
+        const int pa = std::abs(b - c);
+        const int pb = std::abs(a - c);
+        const int pc = std::abs(a + b - 2 * c);
+        if (pa <= pb && pa <= pc)
+            return static_cast<unsigned char>(a);
+        return static_cast<unsigned char>(pb <= pc ? b : c);
+    }
+
+    /*
+     *      (       ).
+     */
+    static void unfilter_row_scalar(int filter, unsigned char* row, const unsigned char* previous, size_t length, int bpp)
+    {
+        switch (filter)
+        {
+        case 1:     // Sub
+            for (size_t i = bpp; i < length; i++)
+                row[i] = static_cast<unsigned char>(row[i] + row[i - bpp]);
+            break;
+        case 2:     // Up
+            for (size_t i = 0; i < length; i++)
+                row[i] = static_cast<unsigned char>(row[i] + previous[i]);
+            break;
+        case 3:     // Average
+            for (size_t i = 0; i < length; i++)
+            {
+                const int left = i >= static_cast<size_t>(bpp) ? row[i - bpp] : 0;
+                row[i] = static_cast<unsigned char>(row[i] + ((left + previous[i]) >> 1));
+            }
+            break;
+        case 4:     // Paeth
+            for (size_t i = 0; i < length; i++)
+            {
+                const int left = i >= static_cast<size_t>(bpp) ? row[i - bpp] : 0;
+                const int upper_left = i >= static_cast<size_t>(bpp) ? previous[i - bpp] : 0;
+                row[i] = static_cast<unsigned char>(row[i] + paeth(left, previous[i], upper_left));
+            }
+            break;
+        default:    // None
+            break;
+        }
+    }
+
+#ifdef CG_DECODER_SSE2
+    static inline __m128i load_pixel(const unsigned char* p, int bpp)
+    {
+        int value = 0;
+        std::memcpy(&value, p, bpp);
+        return _mm_cvtsi32_si128(value);
+    }
+
+    static inline void store_pixel(unsigned char* p, __m128i value, int bpp)
+    {
+        const int result = _mm_cvtsi128_si32(value);
+        std::memcpy(p, &result, bpp);
+    }
+
+    /*
+     *     SSE2  3  4    (RGB, RGBA).
+     * Up    16 ; Sub, Average  Paeth    ,
+     *      ,    .
+     */
+    static void unfilter_row(int filter, unsigned char* row, const unsigned char* previous, size_t length, int bpp)
+    {
+        if (bpp != 3 && bpp != 4)
+        {
+            unfilter_row_scalar(filter, row, previous, length, bpp);
+            return;
+        }
+
+        const __m128i zero = _mm_setzero_si128();
+        switch (filter)
+        {
+        case 1:     // Sub
+        {
+            __m128i left = zero;
+            for (size_t i = 0; i < length; i += bpp)
+            {
+                left = _mm_add_epi8(load_pixel(row + i, bpp), left);
+                store_pixel(row + i, left, bpp);
+            }
+            break;
+        }
+        case 2:     // Up
+        {
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                const __m128i value = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous + i)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), value);
+            }
+            for (; i < length; i++)
+                row[i] = static_cast<unsigned char>(row[i] + previous[i]);
+            break;
+        }
+        case 3:     // Average - _mm_avg_epu8  ,       a ^ b
+        {
+            const __m128i one = _mm_set1_epi8(1);
+            __m128i left = zero;
+            for (size_t i = 0; i < length; i += bpp)
+            {
+                const __m128i up = load_pixel(previous + i, bpp);
+                const __m128i average = _mm_sub_epi8(_mm_avg_epu8(left, up),
+                    _mm_and_si128(_mm_xor_si128(left, up), one));
+                left = _mm_add_epi8(load_pixel(row + i, bpp), average);
+                store_pixel(row + i, left, bpp);
+            }
+            break;
+        }
+        case 4:     // Paeth -    16 
+        {
+            __m128i a = zero;   // 
+            __m128i c = zero;   //  
+            for (size_t i = 0; i < length; i += bpp)
+            {
+                const __m128i b = _mm_unpacklo_epi8(load_pixel(previous + i, bpp), zero);
+
+                __m128i pa = _mm_sub_epi16(b, c);
+                __m128i pb = _mm_sub_epi16(a, c);
+                __m128i pc = _mm_add_epi16(pa, pb);
+                pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+                pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+                pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+
+                // a,  pa <= pb  pa <= pc;  b,  pb <= pc;  c
+                const __m128i use_c = _mm_cmpgt_epi16(pb, pc);
+                const __m128i b_or_c = _mm_or_si128(_mm_and_si128(use_c, c), _mm_andnot_si128(use_c, b));
+                const __m128i use_other = _mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc));
+                const __m128i predictor = _mm_or_si128(_mm_and_si128(use_other, b_or_c), _mm_andnot_si128(use_other, a));
+
+                const __m128i value = _mm_add_epi8(load_pixel(row + i, bpp), _mm_packus_epi16(predictor, predictor));
+                store_pixel(row + i, value, bpp);
+
+                a = _mm_unpacklo_epi8(value, zero);
+                c = b;
+            }
+            break;
+        }
+        default:    // None
+            break;
+        }
+    }
+#else
+    static void unfilter_row(int filter, unsigned char* row, const unsigned char* previous, size_t length, int bpp)
+    {
+        unfilter_row_scalar(filter, row, previous, length, bpp);
+    }
+#endif
+
+    /*
+     * ---------------------------------------------------------------------
+     * PNG
+     * ---------------------------------------------------------------------
+     */
+
+    static const unsigned char png_signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+
+    static uint32_t read_be32(const unsigned char* p)
+    {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+    static bool is_png(const unsigned char* data, size_t size)
+    {
+        return size >= 8 + 25 && std::memcmp(data, png_signature, 8) == 0;
+    }
+
+    /*
+     *   PNG.  false  ,    
+     * (    stb_image).
+     */
+    static bool decode_png(const unsigned char* data,
+        size_t size,
+        unsigned char* pixels,
+        size_t stride,
+        bool flip_vertically)
+    {
+        if (is_png(data, size) == false)
+            return false;
+
+        uint32_t width = 0;
+        uint32_t height = 0;
+        int color_type = -1;
+        unsigned char palette[256][4];
+        int palette_size = 0;
+        for (int i = 0; i < 256; i++)
+        {
+            palette[i][0] = palette[i][1] = palette[i][2] = 0;
+            palette[i][3] = 255;
+        }
+
+        const unsigned char* compressed = nullptr;     // IDAT  (  ,     chunk)
+        size_t compressed_size = 0;
+        std::vector<unsigned char> joined;              //  IDAT chunk-
+
+        size_t position = 8;
+        bool has_header = false;
+        while (position + 12 <= size)
+        {
+            const uint32_t length = read_be32(data + position);
+            const unsigned char* type = data + position + 4;
+            const unsigned char* chunk = data + position + 8;
+            if (length > size - position - 12)
+                return false;
+
+            if (std::memcmp(type, "IHDR", 4) == 0)
+            {
+                //   IHDR    -     pixels ( get_image_info())
+                if (length != 13 || has_header || position != 8)
+                    return false;
+                width = read_be32(chunk);
+                height = read_be32(chunk + 4);
+                const int bit_depth = chunk[8];
+                color_type = chunk[9];
+                const int interlace = chunk[12];
+
+                if (width == 0 || height == 0 || width > max_image_size || height > max_image_size ||
+                    bit_depth != 8 || interlace != 0 ||
+                    (color_type != 0 && color_type != 2 && color_type != 3 && color_type != 4 && color_type != 6))
+                    return false;
+                has_header = true;
+            }
+            else if (std::memcmp(type, "PLTE", 4) == 0)
+            {
+                palette_size = std::min<int>(256, length / 3);
+                for (int i = 0; i < palette_size; i++)
+                {
+                    palette[i][0] = chunk[i * 3 + 0];
+                    palette[i][1] = chunk[i * 3 + 1];
+                    palette[i][2] = chunk[i * 3 + 2];
+                }
+            }
+            else if (std::memcmp(type, "tRNS", 4) == 0)
+            {
+                if (color_type != 3)
+                    return false;   //    /RGB -   stb_image
+                for (uint32_t i = 0; i < std::min<uint32_t>(256, length); i++)
+                    palette[i][3] = chunk[i];
+            }
+            else if (std::memcmp(type, "IDAT", 4) == 0)
+            {
+                if (compressed == nullptr)
+                {
+                    compressed = chunk;
+                    compressed_size = length;
+                }
+                else
+                {
+                    if (joined.empty())
+                        joined.assign(compressed, compressed + compressed_size);
+                    joined.insert(joined.end(), chunk, chunk + length);
+                }
+            }
+            else if (std::memcmp(type, "IEND", 4) == 0)
+            {
+                break;
+            }
+
+            position += 12 + length;
+        }
+
+        if (has_header == false || compressed == nullptr || (color_type == 3 && palette_size == 0))
+            return false;
+        if (joined.empty() == false)
+        {
+            compressed = joined.data();
+            compressed_size = joined.size();
+        }
+
+        static const int channel_counts[7] = { 1, 0, 3, 1, 2, 0, 4 };
+        const int bpp = channel_counts[color_type];
+        const size_t row_size = static_cast<size_t>(width) * bpp;
+
+        std::vector<unsigned char> raw(height * (row_size + 1));
+        if (inflate_zlib(compressed, compressed_size, raw.data(), raw.size()) == false)
+            return false;
+
+        /*
+         *       RGBA    .
+         */
+        const std::vector<unsigned char> zero_row(row_size, 0);
+        const unsigned char* previous = zero_row.data();
+        for (uint32_t y = 0; y < height; y++)
+        {
+            unsigned char* row = raw.data() + y * (row_size + 1);
+            const int filter = row[0];
+            if (filter > 4)
+                return false;
+
+            row++;
+            unfilter_row(filter, row, previous, row_size, bpp);
+            previous = row;
+
+            unsigned char* out = pixels + (flip_vertically ? height - 1 - y : y) * stride;
+            switch (color_type)
+            {
+            case 0:     // 
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    out[x * 4 + 0] = out[x * 4 + 1] = out[x * 4 + 2] = row[x];
+                    out[x * 4 + 3] = 255;
+                }
+                break;
+            case 2:     // RGB
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    out[x * 4 + 0] = row[x * 3 + 0];
+                    out[x * 4 + 1] = row[x * 3 + 1];
+                    out[x * 4 + 2] = row[x * 3 + 2];
+                    out[x * 4 + 3] = 255;
+                }
+                break;
+            case 3:     // 
+                for (uint32_t x = 0; x < width; x++)
+                    std::memcpy(out + x * 4, palette[row[x]], 4);
+                break;
+            case 4:     //   
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    out[x * 4 + 0] = out[x * 4 + 1] = out[x * 4 + 2] = row[x * 2];
+                    out[x * 4 + 3] = row[x * 2 + 1];
+                }
+                break;
+            default:    // RGBA
+                std::memcpy(out, row, row_size);
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    /*
+     * ---------------------------------------------------------------------
+     *  
+     * ---------------------------------------------------------------------
+     */
+
+    /*
+     *     .
+     * -  max_image_size    -   
+     *      ,      .
+     */
+    bool get_image_info(const unsigned char* data, size_t size, int& width, int& height)
+    {
+        if (is_png(data, size) && std::memcmp(data + 12, "IHDR", 4) == 0)
+        {
+            const uint32_t png_width = read_be32(data + 16);
+            const uint32_t png_height = read_be32(data + 20);
+            if (png_width == 0 || png_height == 0 || png_width > max_image_size || png_height > max_image_size)
+                return false;
+            width = static_cast<int>(png_width);
+            height = static_cast<int>(png_height);
+            return true;
+        }
+
+        int bpp = 0;
+        if (size > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+            stbi_info_from_memory(data, static_cast<int>(size), &width, &height, &bpp) == 0)
+            return false;
+        return width > 0 && height > 0 && width <= max_image_size && height <= max_image_size;
+    }
+
+    /*
+     *     RGBA8.
+     * pixels      height   stride 
+     * (     get_image_info()).
+     */
+    bool decode_image(const unsigned char* data,
+        size_t size,
+        unsigned char* pixels,
+        size_t stride,
+        bool flip_vertically)
+    {
+        if (decode_png(data, size, pixels, stride, flip_vertically))
+            return true;
+
+        int expected_width = 0;
+        int expected_height = 0;
+        if (get_image_info(data, size, expected_width, expected_height) == false)
+            return false;
+
+        int width = 0;
+        int height = 0;
+        int bpp = 0;
+        stbi_set_flip_vertically_on_load_thread(flip_vertically ? 1 : 0);
+        unsigned char* decoded = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &bpp, 4);
+        if (decoded == nullptr)
+            return false;
+
+        const bool matches = width == expected_width && height == expected_height;
+        if (matches)
+        {
+            for (int y = 0; y < height; y++)
+                std::memcpy(pixels + y * stride, decoded + static_cast<size_t>(y) * width * 4, static_cast<size_t>(width) * 4);
+        }
+
+        stbi_image_free(decoded);
+        return matches;
+    }
+
+} // namespace cg
@@ -0,0 +1,18 @@
+#ifndef CG_IMAGE_DECODER
+#define CG_IMAGE_DECODER
+
+#include <cstddef>
+
+namespace cg
+{
+
+bool get_image_info(const unsigned char* data, size_t size, int& width, int& height);
+bool decode_image(const unsigned char* data,
+    size_t size,
+    unsigned char* pixels,
+    size_t stride,
+    bool flip_vertically);
+
+} // namespace cg
+
+#endif
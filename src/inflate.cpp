@@ -0,0 +1,460 @@
+#include "inflate.h"
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ *   zlib/deflate  (RFC 1950/1951).
+ *    IDAT   PNG        .
+ */
+namespace cg
+{
+    constexpr int fast_bits = 11;   //           
+
+    /*
+     *   Huffman .
+     * fast[]     fast_bits      ( << 9) | 
+     * (0  , -  fast_bits).
+     * -      max_code/first_code.
+     */
+    struct Huffman
+    {
+        uint16_t fast[1 << fast_bits];
+        uint16_t first_code[17];
+        uint16_t first_symbol[17];
+        uint32_t max_code[18];      //      ,    16 
+        uint16_t symbols[288];
+    };
+
+    /*
+     *      (-  ).
+     */
+    struct BitReader
+    {
+        const unsigned char* data;
+        size_t size;
+        size_t position;
+        uint64_t bits;
+        int count;
+        int overrun;        //  ,     
+    };
+
+    /*
+     *      56 .
+     *      8  ,      ,
+     *     -       .
+     */
+    static inline void refill(BitReader& reader)
+    {
+        if (reader.position + 8 <= reader.size)
+        {
+            uint64_t value;
+            std::memcpy(&value, reader.data + reader.position, 8);     // Little-endian
+            reader.bits |= value << reader.count;
+            reader.position += (63 - reader.count) >> 3;
+            reader.count |= 56;
+            return;
+        }
+
+        while (reader.count <= 56)
+        {
+            uint64_t byte = 0;
+            if (reader.position < reader.size)
+                byte = reader.data[reader.position++];
+            else
+                reader.overrun++;
+
+            reader.bits |= byte << reader.count;
+            reader.count += 8;
+        }
+    }
+
+    /*
+     *      -      count .
+     */
+    static inline unsigned int take_bits(BitReader& reader, int count)
+    {
+        const unsigned int value = static_cast<unsigned int>(reader.bits & ((uint64_t(1) << count) - 1));
+        reader.bits >>= count;
+        reader.count -= count;
+        return value;
+    }
+
+    static unsigned int get_bits(BitReader& reader, int count)
+    {
+        if (reader.count < count)
+            refill(reader);
+
+        const unsigned int value = static_cast<unsigned int>(reader.bits & ((uint64_t(1) << count) - 1));
+        reader.bits >>= count;
+        reader.count -= count;
+        return value;
+    }
+
+    static unsigned int reverse_bits(unsigned int value, int count)
+    {
+        unsigned int result = 0;
+        for (int i = 0; i < count; i++)
+        {
+            result = (result << 1) | (value & 1);
+            value >>= 1;
+        }
+        return result;
+    }
+
+    /*
+     *       .
+     */
+    static bool build_huffman(Huffman& huffman, const unsigned char* lengths, int count)
+    {
+        int sizes[17] = { 0 };
+        int next_code[17] = { 0 };
+
+        std::memset(huffman.fast, 0, sizeof(huffman.fast));
+        for (int i = 0; i < count; i++)
+            sizes[lengths[i]]++;
+        sizes[0] = 0;
+
+        int code = 0;
+        int symbol = 0;
+        for (int length = 1; length <= 16; length++)
+        {
+            next_code[length] = code;
+            huffman.first_code[length] = static_cast<uint16_t>(code);
+            huffman.first_symbol[length] = static_cast<uint16_t>(symbol);
+
+            code += sizes[length];
+            if (sizes[length] != 0 && code - 1 >= (1 << length))
+                return false;   //      
+
+            huffman.max_code[length] = static_cast<uint32_t>(code) << (16 - length);
+            code <<= 1;
+            symbol += sizes[length];
+        }
+        huffman.max_code[17] = 0x10000;
+
+        for (int i = 0; i < count; i++)
+        {
+            const int length = lengths[i];
+            if (length == 0)
+                continue;
+
+            const int index = next_code[length] - huffman.first_code[length] + huffman.first_symbol[length];
+            huffman.symbols[index] = static_cast<uint16_t>(i);
+
+            if (length <= fast_bits)
+            {
+                for (unsigned int j = reverse_bits(next_code[length], length); j < (1u << fast_bits); j += 1u << length)
+                    huffman.fast[j] = static_cast<uint16_t>((length << 9) | i);
+            }
+            next_code[length]++;
+        }
+
+        return true;
+    }
+
+    /*
+     *    .  -1   .
+     *      16 .
+     */
+    static inline int take_symbol(BitReader& reader, const Huffman& huffman)
+    {
+        const int fast = huffman.fast[reader.bits & ((1 << fast_bits) - 1)];
+        if (fast != 0)
+        {
+            const int length = fast >> 9;
+            reader.bits >>= length;
+            reader.count -= length;
+            return fast & 511;
+        }
+
+        const unsigned int code = reverse_bits(static_cast<unsigned int>(reader.bits & 0xFFFF), 16);
+        int length = fast_bits + 1;
+        while (code >= huffman.max_code[length])
+            length++;
+        if (length > 16)
+            return -1;
+
+        const int index = (code >> (16 - length)) - huffman.first_code[length] + huffman.first_symbol[length];
+        if (index >= 288)
+            return -1;
+
+        reader.bits >>= length;
+        reader.count -= length;
+        return huffman.symbols[index];
+    }
+
+    static int decode_symbol(BitReader& reader, const Huffman& huffman)
+    {
+        if (reader.count < 16)
+            refill(reader);
+        return take_symbol(reader, huffman);
+    }
+
+    static const unsigned short length_base[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const unsigned char length_extra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const unsigned short distance_base[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const unsigned char distance_extra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+    /*
+     *   ,   Huffman .
+     *       - 56       (15),
+     *    (5),    (15)    (13).
+     */
+    static bool inflate_block_local(BitReader& reader,
+        const Huffman& literals,
+        const Huffman& distances,
+        unsigned char* out,
+        size_t out_size,
+        size_t& position)
+    {
+        size_t current = position;
+
+        while (true)
+        {
+            if (reader.count < 48)
+                refill(reader);
+
+            const int symbol = take_symbol(reader, literals);
+            if (symbol < 256)
+            {
+                if (symbol < 0 || current >= out_size)
+                    return false;
+                out[current++] = static_cast<unsigned char>(symbol);
+                continue;
+            }
+            if (symbol == 256)
+            {
+                position = current;
+                return true;
+            }
+            if (symbol > 285)
+                return false;
+
+            const int length_symbol = symbol - 257;
+            const size_t length = length_base[length_symbol] + take_bits(reader, length_extra[length_symbol]);
+
+            const int distance_symbol = take_symbol(reader, distances);
+            if (distance_symbol < 0 || distance_symbol >= 30)
+                return false;
+            const size_t distance = distance_base[distance_symbol] + take_bits(reader, distance_extra[distance_symbol]);
+
+            if (distance > current || length > out_size - current)
+                return false;
+
+            /*
+             *   .    8 
+             *      8  ,     .
+             *  1     .
+             */
+            unsigned char* destination = out + current;
+            const unsigned char* source = destination - distance;
+            if (distance >= 8 && current + length + 8 <= out_size)
+            {
+                for (size_t i = 0; i < length; i += 8)
+                    std::memcpy(destination + i, source + i, 8);
+            }
+            else if (distance == 1)
+            {
+                std::memset(destination, *source, length);
+            }
+            else if (current + length + 8 <= out_size)
+            {
+                /*
+                 *   (   RGBA ) - 8    
+                 *    ,   .
+                 */
+                unsigned char pattern[8];
+                for (size_t i = 0; i < 8; i++)
+                    pattern[i] = source[i % distance];
+
+                const size_t step = 8 - 8 % distance;
+                for (size_t i = 0; i < length; i += step)
+                    std::memcpy(destination + i, pattern, 8);
+            }
+            else
+            {
+                for (size_t i = 0; i < length; i++)
+                    destination[i] = source[i];
+            }
+            current += length;
+        }
+    }
+
+    /*
+     *        ,      -
+     *     out          .
+     */
+    static bool inflate_block(BitReader& reader,
+        const Huffman& literals,
+        const Huffman& distances,
+        unsigned char* out,
+        size_t out_size,
+        size_t& position)
+    {
+        BitReader local = reader;
+        const bool result = inflate_block_local(local, literals, distances, out, out_size, position);
+        reader = local;
+        return result;
+    }
+
+    /*
+     *      .
+     */
+    static bool read_dynamic_tables(BitReader& reader, Huffman& literals, Huffman& distances)
+    {
+        static const unsigned char order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+        const int literal_count = get_bits(reader, 5) + 257;
+        const int distance_count = get_bits(reader, 5) + 1;
+        const int code_length_count = get_bits(reader, 4) + 4;
+        if (literal_count > 286 || distance_count > 30)
+            return false;   // HLIT  HDIST     288  32,      
+
+        unsigned char code_lengths[19] = { 0 };
+        for (int i = 0; i < code_length_count; i++)
+            code_lengths[order[i]] = static_cast<unsigned char>(get_bits(reader, 3));
+
+        Huffman code_length_huffman;
+        if (build_huffman(code_length_huffman, code_lengths, 19) == false)
+            return false;
+
+        unsigned char lengths[286 + 30];
+        int count = 0;
+        const int total = literal_count + distance_count;
+        while (count < total)
+        {
+            const int symbol = decode_symbol(reader, code_length_huffman);
+            if (symbol < 0)
+                return false;
+
+            if (symbol < 16)
+            {
+                lengths[count++] = static_cast<unsigned char>(symbol);
+                continue;
+            }
+
+            unsigned char value = 0;
+            int repeat = 0;
+            if (symbol == 16)
+            {
+                if (count == 0)
+                    return false;
+                value = lengths[count - 1];
+                repeat = 3 + get_bits(reader, 2);
+            }
+            else if (symbol == 17)
+            {
+                repeat = 3 + get_bits(reader, 3);
+            }
+            else
+            {
+                repeat = 11 + get_bits(reader, 7);
+            }
+
+            if (count + repeat > total)
+                return false;
+            std::memset(lengths + count, value, repeat);
+            count += repeat;
+        }
+
+        return build_huffman(literals, lengths, literal_count) &&
+            build_huffman(distances, lengths + literal_count, distance_count);
+    }
+
+    /*
+     *   zlib       .
+     *   (Adler-32)   .
+     */
+    bool inflate_zlib(const unsigned char* data, size_t size, unsigned char* out, size_t out_size)
+    {
+        if (size < 2)
+            return false;
+
+        const int method = data[0];
+        const int flags = data[1];
+        if ((method & 15) != 8 || (method * 256 + flags) % 31 != 0 || (flags & 32) != 0)
+            return false;   //  deflate,  
+
+        BitReader reader = { data, size, 2, 0, 0, 0 };
+        size_t position = 0;
+
+        static Huffman fixed_literals;
+        static Huffman fixed_distances;
+        static const bool fixed_ready = []
+        {
+            unsigned char lengths[288];
+            std::memset(lengths, 8, 144);
+            std::memset(lengths + 144, 9, 112);
+            std::memset(lengths + 256, 7, 24);
+            std::memset(lengths + 280, 8, 8);
+            build_huffman(fixed_literals, lengths, 288);
+
+            std::memset(lengths, 5, 30);
+            build_huffman(fixed_distances, lengths, 30);
+            return true;
+        }();
+        (void)fixed_ready;
+
+        bool final_block = false;
+        while (final_block == false)
+        {
+            final_block = get_bits(reader, 1) != 0;
+            const unsigned int type = get_bits(reader, 2);
+
+            if (type == 0)
+            {
+                /*
+                 *   -      .
+                 */
+                get_bits(reader, reader.count % 8);
+                reader.position -= reader.count / 8 - reader.overrun;
+                reader.bits = 0;
+                reader.count = 0;
+                reader.overrun = 0;
+
+                if (reader.position + 4 > size)
+                    return false;
+                const size_t length = data[reader.position] | (data[reader.position + 1] << 8);
+                const size_t inverted = data[reader.position + 2] | (data[reader.position + 3] << 8);
+                reader.position += 4;
+
+                if ((length ^ 0xFFFF) != inverted || reader.position + length > size || length > out_size - position)
+                    return false;
+
+                std::memcpy(out + position, data + reader.position, length);
+                reader.position += length;
+                position += length;
+            }
+            else if (type == 1)
+            {
+                if (inflate_block(reader, fixed_literals, fixed_distances, out, out_size, position) == false)
+                    return false;
+            }
+            else if (type == 2)
+            {
+                Huffman literals;
+                Huffman distances;
+                if (read_dynamic_tables(reader, literals, distances) == false ||
+                    inflate_block(reader, literals, distances, out, out_size, position) == false)
+                    return false;
+            }
+            else
+            {
+                return false;
+            }
+
+            if (reader.overrun > 8)
+                return false;   //   
+        }
+
+        return position == out_size;
+    }
+
+} // namespace cg
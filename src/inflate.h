@@ -0,0 +1,13 @@
+#ifndef CG_INFLATE
+#define CG_INFLATE
+
+#include <cstddef>
+
+namespace cg
+{
+
+bool inflate_zlib(const unsigned char* data, size_t size, unsigned char* out, size_t out_size);
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,153 @@
+#include "glad/glad.h"
+
+#include "lighting.h"
+#include "gl_resource.h"
+#include "gl_state.h"
+#include "shader.h"
+#include "stream_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace cg
+{
+    constexpr const char* cluster_compute_shader = "resources/shaders/cluster_c.glsl";
+    constexpr unsigned int cluster_count = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+
+    /*
+     *   ,     SSBO (std430, 32 ).
+     */
+    struct GpuLight
+    {
+        glm::vec4 position_radius;      // xyz - , w - 
+        glm::vec4 color_intensity;      // rgb - , a - 
+    };
+
+    /*
+     *    (std140),   compute  fragment .
+     */
+    struct ClusterParams
+    {
+        glm::uvec4 grid;                //   , w -  
+        glm::vec4 screen;               //        
+        glm::vec4 depth;                //    ,     
+        glm::mat4 view;                 // View  (    )
+        glm::mat4 inverse_projection;   //      view 
+    };
+
+    static_assert(sizeof(GpuLight) == 32, "GpuLight must match the std430 layout in the shaders");
+    static_assert(sizeof(ClusterParams) == 176, "ClusterParams must match the std140 layout in the shaders");
+
+    static std::vector<GpuLight> g_lights;      // ,    
+    static int g_light_count = 0;               //     
+    static int g_cluster_program = -1;          // Compute   
+    static GlBuffer g_count_buffer;             // SSBO      
+    static GlBuffer g_index_buffer;             // SSBO      
+
+    /*
+     *        compute .
+     *        (MAX_CLUSTER_LIGHTS),
+     *          .
+     *            .
+     */
+    void init_lighting(void)
+    {
+        g_cluster_program = add_compute_program(cluster_compute_shader);
+
+        //      compute  -      CPU
+        g_count_buffer = GlBuffer(cluster_count * sizeof(unsigned int), nullptr, 0);
+        g_count_buffer.clear_uint(0);   //  compute   ,   
+        bind_buffer_base(GL_SHADER_STORAGE_BUFFER, CLUSTER_COUNT_BINDING, g_count_buffer.id());
+
+        g_index_buffer = GlBuffer(cluster_count * MAX_CLUSTER_LIGHTS * sizeof(unsigned int), nullptr, 0);
+        bind_buffer_base(GL_SHADER_STORAGE_BUFFER, CLUSTER_LIGHTS_BINDING, g_index_buffer.id());
+    }
+
+    /*
+     *      .
+     *     update_lighting(),       .
+     */
+    void add_light(const PointLight& light)
+    {
+        g_lights.push_back({ glm::vec4(light.position, light.radius), glm::vec4(light.color, light.intensity) });
+    }
+
+    /*
+     *          compute .
+     *        ,    -  .
+     *             
+     *  ,    AABB        .
+     *      ,   ,
+     *  begin_stream_frame()  end_stream_frame().
+     */
+    void update_lighting(const glm::mat4& view, const glm::mat4& projection,
+        float z_near, float z_far, int width, int height)
+    {
+        g_light_count = static_cast<int>(g_lights.size());
+
+        const StreamAllocation params_allocation = allocate_stream(GL_UNIFORM_BUFFER, sizeof(ClusterParams));
+        if (params_allocation.data == nullptr)
+        {
+            g_lights.clear();
+            return;
+        }
+
+        const float slices = static_cast<float>(CLUSTER_GRID_Z);
+        const float log_ratio = std::log(z_far / z_near);
+        ClusterParams& params = *static_cast<ClusterParams*>(params_allocation.data);
+        params.grid = glm::uvec4(CLUSTER_GRID_X, CLUSTER_GRID_Y, CLUSTER_GRID_Z, g_lights.size());
+        params.screen = glm::vec4(width, height,
+            static_cast<float>(width) / CLUSTER_GRID_X,
+            static_cast<float>(height) / CLUSTER_GRID_Y);
+        params.depth = glm::vec4(z_near, z_far,
+            slices / log_ratio,                     //  = log(z) *  + 
+            -slices * std::log(z_near) / log_ratio);
+        params.view = view;
+        params.inverse_projection = glm::inverse(projection);
+        bind_buffer_range(GL_UNIFORM_BUFFER, CLUSTER_PARAMS_BINDING,
+            params_allocation.buffer, params_allocation.offset, params_allocation.size);
+
+        //        -       
+        const StreamAllocation light_allocation = allocate_stream(GL_SHADER_STORAGE_BUFFER,
+            std::max<size_t>(g_lights.size(), 1) * sizeof(GpuLight));
+        if (light_allocation.data != nullptr)
+        {
+            if (g_lights.empty() == false)
+                std::memcpy(light_allocation.data, g_lights.data(), g_lights.size() * sizeof(GpuLight));
+            bind_buffer_range(GL_SHADER_STORAGE_BUFFER, LIGHT_BINDING,
+                light_allocation.buffer, light_allocation.offset, light_allocation.size);
+        }
+
+        unsigned int program = get_program(g_cluster_program);
+        if (program != 0)
+        {
+            bind_program(program);
+            glDispatchCompute(CLUSTER_GRID_Z, 1, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);     // Fragment   
+        }
+
+        g_lights.clear();
+    }
+
+    /*
+     *     .
+     */
+    int get_light_count(void)
+    {
+        return g_light_count;
+    }
+
+    /*
+     *   .     cleanup_shaders().
+     */
+    void cleanup_lighting(void)
+    {
+        g_count_buffer.reset();
+        g_index_buffer.reset();
+        g_cluster_program = -1;
+        g_lights.clear();
+    }
+
+} // namespace cg
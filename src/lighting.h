@@ -0,0 +1,45 @@
+#ifndef CG_LIGHTING
+#define CG_LIGHTING
+
+#include <glm/glm.hpp>
+
+namespace cg
+{
+
+/*
+ *     .
+ *       radius -     ,
+ *         .
+ */
+struct PointLight
+{
+    glm::vec3 position = glm::vec3(0.0f);   //    
+    float radius = 1.0f;                    //   
+    glm::vec3 color = glm::vec3(1.0f);      //   
+    float intensity = 1.0f;                 //   
+};
+
+/*
+ *       :   
+ *     (,       ).
+ */
+constexpr unsigned int CLUSTER_GRID_X = 16;    // X  Y   local_size  cluster_c.glsl
+constexpr unsigned int CLUSTER_GRID_Y = 9;
+constexpr unsigned int CLUSTER_GRID_Z = 24;
+constexpr unsigned int MAX_CLUSTER_LIGHTS = 128;    //     cluster_c.glsl
+
+constexpr unsigned int CLUSTER_PARAMS_BINDING = 0;  // Binding   UBO    
+constexpr unsigned int LIGHT_BINDING = 2;           // Binding   SSBO  
+constexpr unsigned int CLUSTER_COUNT_BINDING = 3;   // Binding   SSBO     
+constexpr unsigned int CLUSTER_LIGHTS_BINDING = 4;  // Binding   SSBO    
+
+void init_lighting(void);
+void add_light(const PointLight& light);
+void update_lighting(const glm::mat4& view, const glm::mat4& projection,
+    float z_near, float z_far, int width, int height);
+int get_light_count(void);
+void cleanup_lighting(void);
+
+} // namespace cg
+
+#endif
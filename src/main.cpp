@@ -3,13 +3,29 @@
 
 #include "ui.h"
 #include "structs.h"
-#include "vendor/stb_image.h"
-
+#include "archive.h"
+#include "asset.h"
+#include "command_list.h"
+#include "gl_ext.h"
+#include "gl_resource.h"
+#include "gl_state.h"
+#include "lighting.h"
+#include "material.h"
+#include "mesh.h"
+#include "mesh_cache.h"
+#include "redraw.h"
+#include "render_queue.h"
+#include "scene_target.h"
+#include "shader.h"
+#include "stream_buffer.h"
+#include "texture.h"
+#include "thread_pool.h"
+
+#include <algorithm>
 #include <array>
-#include <fstream>
 #include <iostream>
-#include <optional>
 #include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -18,13 +34,49 @@
  * .
  */
 constexpr auto clear_color = glm::vec4(0.45f, 0.55f, 0.60f, 0.90f);
+constexpr const char* tex_vertex_shader = "resources/shaders/tex_v.glsl";
+constexpr const char* tex_fragment_shader = "resources/shaders/tex_f.glsl";
+constexpr std::array<const char*, 2> body_texture_paths = {
+    "resources/textures/tu_white.png",
+    "resources/textures/tu_transparent.png",
+};
+constexpr const char* part_model_directory = "resources/models/";
+constexpr std::array<const char*, PART_COUNT> part_model_names = {
+    "body", "head", "arm", "leg", "eye", "antenna", "shoulder", "hip", "forearm", "shin"
+};
 
 /*
  *  .  .
  */
-static std::unordered_map<std::string, int> g_uniform_locations;
+static std::unordered_map<unsigned int, std::unordered_map<std::string, int>> g_uniform_locations;
+static unsigned int g_uniform_generation = 0;   //   ,     
 static unsigned int g_program = 0;
-static glm::mat4 g_model = glm::mat4(1.0f);
+static std::array<int, 2> g_body_textures = { -1, -1 };    //    (   )
+static std::array<int, 4> g_variant_programs = { -1, -1, -1, -1 };     //   tex  -> 
+static unsigned int g_cube_mesh = 0;        //    ( init_cube_mesh())
+static std::array<unsigned int, PART_COUNT> g_part_meshes = {};     //     (,   )
+static std::array<glm::mat4, PART_COUNT> g_part_fits;               //        ( fit_to_unit_cube())
+static cg::Asset<bool> g_robot;     //       ( load_robot())
+static thread_local glm::mat4 g_model = glm::mat4(1.0f);
+
+/*
+ *     .
+ *     ,      -  
+ *    ( render()). g_model, g_team  g_recording    
+ * ,   draw_robot()  draw_cuboid()        .
+ */
+static std::vector<cg::CommandList> g_slices;       //        
+static cg::CommandList g_frame_commands;            //    
+static thread_local cg::CommandList* g_recording = nullptr;     // ,    
+static std::vector<cg::RenderItem> g_queue;     //   ,   
+
+/*
+ *   .
+ *    PART_COUNT  ,   g_palette_base.
+ */
+constexpr int team_count = 4;
+static unsigned int g_palette_base = 0;
+static thread_local int g_team = 0;     //   ,     
 
 static glm::vec3 g_light_pos = glm::vec3(1.0f, 1.0f, 2.0f);
 static glm::vec3 g_light_color = glm::vec3(1.0f); /* White light */
@@ -36,12 +88,11 @@ float g_rotation_speed = 2.0f;  // 
 /*
  *    .
  */
-static void set_model(unsigned int);
 static void set_view(unsigned int);
 static void set_projection(unsigned int);
 static void set_light_pos(unsigned int);
 static void set_light_color(unsigned int);
-static void draw_cuboid(const glm::vec3& size);
+static void draw_cuboid(const glm::vec3& size, RobotPart part);
 static void draw_robot();
 
 /*
@@ -67,6 +118,12 @@ static void glfw_error_callback(int error, const char* description)
     std::cerr << "GLFW Error: " << error << " " << description << std::endl;
 }
 
+/*
+ *  ,     .
+ * ImGui    ( ,   )    .
+ */
+constexpr int input_redraw_frames = 2;
+
 /*
  * Callback     .
  *        .
@@ -78,6 +135,8 @@ static void key_callback(GLFWwindow* window,
     int action,
     int mode)
 {
+    cg::request_redraw(input_redraw_frames);
+
     if (action == GLFW_PRESS || action == GLFW_REPEAT)
     {
         switch (key)
@@ -183,11 +242,49 @@ static void size_callback(GLFWwindow* window, int width, int height)
     if (width == 0 || height == 0)
         return;
 
-    glViewport(0, 0, width, height);
+    cg::set_viewport(0, 0, width, height);
+    cg::window.window_width = width;
+    cg::window.window_height = height;
     cg::perspective.aspect = static_cast<float>(width) / height;
-    set_projection(g_program);
+    if (g_program != 0)
+        set_projection(g_program);
+    cg::request_redraw();
 };
 
+/*
+ * Callback     (, , )     .
+ *      ImGui,     -      .
+ */
+static void cursor_callback(GLFWwindow* window, double x, double y)
+{
+    cg::request_redraw(input_redraw_frames);
+}
+
+static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+{
+    cg::request_redraw(input_redraw_frames);
+}
+
+static void scroll_callback(GLFWwindow* window, double x, double y)
+{
+    cg::request_redraw(input_redraw_frames);
+}
+
+static void char_callback(GLFWwindow* window, unsigned int codepoint)
+{
+    cg::request_redraw(input_redraw_frames);
+}
+
+static void focus_callback(GLFWwindow* window, int focused)
+{
+    cg::request_redraw(input_redraw_frames);
+}
+
+static void refresh_callback(GLFWwindow* window)
+{
+    cg::request_redraw();
+}
+
 /*
  *    .
  *  GLFW     OpenGL .
@@ -204,7 +301,7 @@ GLFWwindow* init_window(void)
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
 
-    glfwWindowHint(GLFW_SAMPLES, 4);
+    glfwWindowHint(GLFW_SAMPLES, 0);    //       ( scene_target.h)
 
     /*
      *        .
@@ -230,12 +327,19 @@ GLFWwindow* init_window(void)
      */
     glfwSetKeyCallback(window, key_callback);           // Callback  
     glfwSetWindowSizeCallback(window, size_callback);   // Callback  
+    glfwSetCursorPosCallback(window, cursor_callback);              //   
+    glfwSetMouseButtonCallback(window, mouse_button_callback);      //   
+    glfwSetScrollCallback(window, scroll_callback);                 //   
+    glfwSetCharCallback(window, char_callback);                     //   
+    glfwSetWindowFocusCallback(window, focus_callback);             //   
+    glfwSetWindowRefreshCallback(window, refresh_callback);         //     
 
     /*
      *   OpenGL   GLAD.
      *        OpenGL   .
      */
     gladLoadGL();
+    cg::init_gl_extensions();   //   ,     GLAD
 
     return window;
 }
@@ -262,114 +366,28 @@ static void cleanup_window(GLFWwindow* window)
     glfwTerminate();    //   GLFW
 }
 
-/*
- *     .
- *      string.
- */
-static std::optional<std::string> read_shader(const std::string& path)
-{
-    std::string result;
-
-    std::ifstream in(path, std::ios::in | std::ios::binary);
-    if (in.good() == false)
-        return std::nullopt;
-
-    in.seekg(0, std::ios::end);
-    size_t size = in.tellg();
-
-    if (size == -1)
-        return std::nullopt;
-
-    result.resize(size);
-    in.seekg(0, std::ios::beg);
-    in.read(&result[0], size);
-
-    return result;
-}
-
-/*
- *   .
- *         .
- * c_str          .
- */
-static unsigned int compile_shader(const std::string shader_source,
-    unsigned int type)
-{
-    unsigned int shader = glCreateShader(type);     //    
-
-    const char* c_str = shader_source.c_str();
-    glShaderSource(shader, 1, &c_str, nullptr);     //    
-
-    glCompileShader(shader);    //   
-
-    /*
-     *     .
-     */
-    int is_compiled = 0;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &is_compiled);
-    if (is_compiled == 0)
-    {
-        std::string log;
-        int length = 0;
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);     //       
-        log.resize(length);
-        glGetShaderInfoLog(shader, length, nullptr, &log[0]);   //     
-
-        std::string type_s = type == GL_VERTEX_SHADER ? "vertex" : "fragment";
-        std::cerr << "Failed to compile " << type_s << " shader." << std::endl;
-        std::cerr << log << std::endl;
-
-        glDeleteShader(shader);
-        return 0;
-    }
-
-    return shader;
-}
-
-/*
- *      .
- *  vertex  fragment    .
- */
-static unsigned int create_shader(const std::string& vertex_source,
-    const std::string& fragment_source)
-{
-	unsigned int program = glCreateProgram();   //    
-    unsigned int vertex_shader = compile_shader(vertex_source, GL_VERTEX_SHADER);
-    if (vertex_shader == 0)
-        return 0;
-    unsigned int fragment_shader = compile_shader(fragment_source, GL_FRAGMENT_SHADER);
-    if (fragment_shader == 0)
-        return 0;
-
-    glAttachShader(program, vertex_shader);     //   vertex 
-    glAttachShader(program, fragment_shader);   //   fragment 
-    glLinkProgram(program);     //   
-    glValidateProgram(program);     //   
-
-    glDeleteShader(vertex_shader);      //     
-    glDeleteShader(fragment_shader);
-
-    glDetachShader(program, vertex_shader);     //   
-    glDetachShader(program, fragment_shader);
-
-    return program;
-}
-
 /*
  *     uniform   .
  *    - .
  */
 int get_uniform_location(unsigned int program, const std::string& location)
 {
-    if (g_uniform_locations.find(location) != g_uniform_locations.end())
-        return g_uniform_locations[location];   //      
+    if (g_uniform_generation != cg::get_programs_generation())
+    {
+        g_uniform_locations.clear();    //           
+        g_uniform_generation = cg::get_programs_generation();
+    }
+
+    auto& locations = g_uniform_locations[program];
+    if (locations.find(location) != locations.end())
+        return locations[location];     //      
 
     int uniform = glGetUniformLocation(program, location.c_str());      //     OpenGL
     if (uniform == -1)
         std::cout << "Warning: Uniform " << location <<
         " does not exist. This uniform will not be set." << std::endl;
 
-    g_uniform_locations[location] = uniform;       //   
+    locations[location] = uniform;      //   
     return uniform;
 }
 
@@ -399,15 +417,6 @@ static void set_matrix(unsigned int program,
     glUniformMatrix4fv(uniform, 1, false, glm::value_ptr(matrix));
 }
 
-/*
- *      .
- *       (, , ).
- */
-static void set_model(unsigned int program)
-{
-    set_matrix(program, g_model, "u_model");
-}
-
 /*
  *   view   .
  * View       .
@@ -453,11 +462,11 @@ static void set_light_color(unsigned int program)
 }
 
 /*
- * Vertex Buffer Object (VBO).
- *        GPU.
- *      (, ,  ).
+ *   .
+ *      (, ,  )
+ *      ( mesh.h)     .
  */
-static unsigned int init_vbo(void)
+static unsigned int init_cube_mesh(void)
 {
     /*
      *   .
@@ -521,188 +530,539 @@ static unsigned int init_vbo(void)
          -0.5f, -0.5f, -0.5f,   0.0f, -1.0f,  0.0f,   0.0f, 0.0f
     };
 
-    unsigned int vbo = 0;
-    glGenBuffers(1, &vbo);      //   VBO
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);     //   VBO
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices[0], GL_STATIC_DRAW);      //     GPU 
+    /*
+     *     ,         :
+     *      (36   24 ).
+     */
+    std::vector<cg::MeshVertex> unique;
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < vertices.size(); i += 8)
+    {
+        const cg::MeshVertex vertex = {
+            glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2]),
+            glm::vec3(vertices[i + 3], vertices[i + 4], vertices[i + 5]),
+            glm::vec2(vertices[i + 6], vertices[i + 7])
+        };
+
+        auto found = std::find_if(unique.begin(), unique.end(), [&vertex](const cg::MeshVertex& other)
+            {
+                return other.position == vertex.position && other.normal == vertex.normal &&
+                    other.tex_coord == vertex.tex_coord;
+            });
+        if (found == unique.end())
+            found = unique.insert(unique.end(), vertex);
+        indices.push_back(static_cast<uint32_t>(found - unique.begin()));
+    }
+
+    return cg::add_mesh(unique, indices);
+}
+
+/*
+ *       .
+ *   ,     Phong .
+ *   ,      ,     .
+ */
+static unsigned int part_variant(RobotPart part)
+{
+    if (part == PART_BODY)
+        return cg::SHADER_LIT | cg::SHADER_TEXTURED;
+    return cg::SHADER_LIT;
+}
+
+/*
+ *        .
+ *  0     .
+ */
+static void init_robot_materials(void)
+{
+    const std::array<glm::vec3, team_count> team_colors =
+    {
+        glm::vec3(0.3f, 0.5f, 0.8f),    //  
+        glm::vec3(0.8f, 0.3f, 0.3f),    //  
+        glm::vec3(0.3f, 0.7f, 0.35f),   //  
+        glm::vec3(0.85f, 0.55f, 0.2f)   //  
+    };
 
-    return vbo;
+    for (int team = 0; team < team_count; team++)
+    {
+        const glm::vec3 base = team_colors[team];
+        const glm::vec3 light = glm::min(base + glm::vec3(0.1f), glm::vec3(1.0f));     // - -  
+        const glm::vec3 dark = glm::max(base - glm::vec3(0.1f), glm::vec3(0.0f));      // - -    
+
+        std::array<cg::Material, PART_COUNT> parts;
+        parts[PART_BODY].color = glm::vec4(base, 1.0f);
+        parts[PART_BODY].texture = g_body_textures[team % g_body_textures.size()];
+        parts[PART_HEAD].color = glm::vec4(light, 1.0f);
+        parts[PART_ARM].color = glm::vec4(dark, 1.0f);
+        parts[PART_LEG].color = glm::vec4(dark, 1.0f);
+        parts[PART_EYE].color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);       //  
+        parts[PART_EYE].emissive = 1.0f;                                  //   
+        parts[PART_ANTENNA].color = glm::vec4(1.0f, 1.0f, 0.0f, 1.0f);   //  
+        parts[PART_SHOULDER].color = glm::vec4(base, 1.0f);
+        parts[PART_HIP].color = glm::vec4(base, 1.0f);
+        parts[PART_FOREARM].color = glm::vec4(dark, 1.0f);
+        parts[PART_SHIN].color = glm::vec4(dark, 1.0f);
+
+        for (int part = 0; part < PART_COUNT; part++)
+        {
+            unsigned int index = cg::add_material(parts[part]);
+            if (team == 0 && part == 0)
+                g_palette_base = index;
+        }
+    }
 }
 
 /*
- * Vertex Array Object (VAO).
- *      .
- *        VBO.
+ *     .
+ * Uniform       ,
+ *         .
  */
-static unsigned int init_vao(void)
+static void use_program(unsigned int program, unsigned int variant)
 {
-    unsigned int vao = 0;
-    glGenVertexArrays(1, &vao);     //   VAO
-    glBindVertexArray(vao);     //   VAO
+    cg::bind_program(program);
+    g_program = program;
 
     /*
-     *    ( 0).
-     * 3 float ,  8*sizeof(float),  0.
+	*        .
+    */
+    set_view(program);
+    set_projection(program);
+
+    /*
+	 *     .
      */
-    glVertexAttribPointer(0, 3, GL_FLOAT, false, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    if (variant & cg::SHADER_LIT)
+    {
+        set_light_pos(program);
+        set_light_color(program);
+    }
+}
 
+/*
+ *   OpenGL    ,   .
+ */
+static bool init_gl_state(void)
+{
     /*
-     *    ( 1).
-     * 3 float ,  8*sizeof(float),  3*sizeof(float).
+     *   Z- ()  .
      */
-    glVertexAttribPointer(1, 3, GL_FLOAT, false, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    cg::set_capability(GL_DEPTH_TEST, true);    //     
+    cg::set_capability(GL_MULTISAMPLE, true);   //   -
 
     /*
-     *     ( 2).
-     * 2 float ,  8*sizeof(float),  6*sizeof(float).
+     *    (blending).
+     *         flush_draws().
      */
-    glVertexAttribPointer(2, 2, GL_FLOAT, false, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    cg::set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  //   
+    cg::set_capability(GL_BLEND, false);
+
+    cg::init_textures();        // -    
+    cg::init_shaders();
+    if (cg::has_bindless_textures())
+        cg::add_shader_define("BINDLESS");
 
-    return vao;
+    cg::init_stream_buffer();   //      (, , )
+    cg::init_meshes();          //    
+    cg::init_materials();       //   
+    cg::init_lighting();        //     compute 
+    cg::init_scene_target();    //     
+
+    std::cout << "Data init check:" << std::endl;
+    return gl_print_error() == 0;   //   
 }
 
 /*
- *       .
- *   stb_image    .
+ *   ,       .
+ *     -     .
  */
-static unsigned int init_texture(const std::string& path)
+static cg::Asset<unsigned int> load_cube_mesh(void)
 {
-    int texture_width = 0;
-    int texture_height = 0;
-    int texture_bpp = 0;
+    co_await cg::resume_on_render_thread();
 
-    stbi_set_flip_vertically_on_load(1);        //     (OpenGL )
+    co_return init_cube_mesh();
+}
 
-    unsigned char* texture_data = stbi_load(path.c_str(),
-        &texture_width,
-        &texture_height,
-        &texture_bpp,
-        4);     //   RGBA (4 )
+/*
+ *    .
+ *         ,
+ *        .
+ */
+static cg::Asset<bool> load_robot_materials(void)
+{
+    //       ,     
+    std::array<cg::Asset<int>, body_texture_paths.size()> textures;
+    for (size_t i = 0; i < body_texture_paths.size(); i++)
+        textures[i] = cg::load_texture_async(body_texture_paths[i]);
 
-    if (texture_data == nullptr)
+    std::array<cg::Asset<int>, PART_COUNT> programs;
+    for (int part = 0; part < PART_COUNT; part++)
+        programs[part] = cg::load_program_async(tex_vertex_shader, tex_fragment_shader,
+            part_variant(static_cast<RobotPart>(part)));
+
+    for (int part = 0; part < PART_COUNT; part++)
     {
-        std::cerr << "Failed to load texture." << std::endl;
-        return 0;
+        const int program = co_await programs[part];
+        if (program == -1)
+        {
+            std::cerr << "Failed to compile shaders." << std::endl;
+            co_return false;
+        }
+        g_variant_programs[part_variant(static_cast<RobotPart>(part))] = program;
     }
 
-    unsigned int texture = 0;
-    glGenTextures(1, &texture);     //   
-    glBindTexture(GL_TEXTURE_2D, texture);      //   
+    for (size_t i = 0; i < body_texture_paths.size(); i++)
+        g_body_textures[i] = co_await textures[i];
 
-    /*
-     *       .
-     *  .
-     */
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);    //   X
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);    //   Y
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);       //   
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);       //   
+    co_await cg::resume_on_render_thread();
+    init_robot_materials();
+    co_return true;
+}
 
-    glTexImage2D(GL_TEXTURE_2D,     //       GPU
-        0,
-        GL_RGBA8,
-        texture_width,
-        texture_height,
-        0,
-        GL_RGBA,
-        GL_UNSIGNED_BYTE,
-        texture_data);
+/*
+ * ,      [-0.5, 0.5]   ,    
+ *   (draw_cuboid()      ).    
+ * ,     -       .   
+ *  ,           .
+ */
+static glm::mat4 fit_to_unit_cube(const glm::vec3& bounds_min, const glm::vec3& bounds_max)
+{
+    const glm::vec3 center = (bounds_min + bounds_max) * 0.5f;
+    const glm::vec3 extent = glm::max(bounds_max - bounds_min, glm::vec3(1e-6f));
+    return glm::translate(glm::scale(glm::mat4(1.0f), 1.0f / extent), -center);
+}
 
-    glGenerateMipmap(GL_TEXTURE_2D);        //   
-    glActiveTexture(GL_TEXTURE0);           //    unit 0
-    glBindTexture(GL_TEXTURE_2D, texture);  //   
+/*
+ *       resources/models/<>.glb  .obj ( part_model_names).
+ *      <>.cgmesh ( load_mesh()) -   
+ *        ,     
+ *     .       -1,   .
+ */
+static cg::Asset<int> load_part_mesh(RobotPart part)
+{
+    co_await cg::resume_on_worker();
 
-    stbi_image_free(texture_data);      //     
-    return texture;
+    cg::MeshFile mesh;
+    if (cg::load_mesh(std::string(part_model_directory) + part_model_names[part], mesh) == false)
+        co_return -1;
+
+    co_await cg::resume_on_render_thread();
+    const unsigned int id = cg::add_mesh(mesh.vertices, mesh.indices, mesh.lods);
+    g_part_fits[part] = fit_to_unit_cube(mesh.bounds_min, mesh.bounds_max);
+    cg::close_mesh_file(mesh);
+    co_return static_cast<int>(id);
 }
 
 /*
- *    .
- * ,    vertex  fragment .
+ *    -     .
+ *      .
+ *    ,    .
  */
-static unsigned int init_program(const std::string& vertex_path,
-    const std::string& fragment_path)
+static cg::Asset<bool> load_robot(void)
 {
-    const auto vertex_source = read_shader(vertex_path);        //   vertex 
-    const auto fragment_source = read_shader(fragment_path);    //   fragment 
-    if (vertex_source.has_value() == false ||
-        fragment_source.has_value() == false)
-    {
-        std::cerr << "Failed to read shaders." << std::endl;
-        return 0;
-    }
+    cg::Asset<unsigned int> mesh = load_cube_mesh();
+    cg::Asset<bool> materials = load_robot_materials();
 
-    unsigned int program = create_shader(vertex_source.value(),
-        fragment_source.value());       //    
+    std::array<cg::Asset<int>, PART_COUNT> part_meshes;
+    for (int part = 0; part < PART_COUNT; part++)
+        part_meshes[part] = load_part_mesh(static_cast<RobotPart>(part));
 
-    return program;
+    g_cube_mesh = co_await mesh;
+    for (int part = 0; part < PART_COUNT; part++)
+    {
+        const int part_mesh = co_await part_meshes[part];
+        g_part_meshes[part] = part_mesh != -1 ? static_cast<unsigned int>(part_mesh) : g_cube_mesh;
+    }
+    co_return co_await materials;
 }
 
 /*
  *   .
- *  OpenGL ,    .
+ *      ( asset.h):     
+ *       ,    
+ *   OpenGL .   OpenGL     
+ * update_async()   ,    .
+ *   OpenGL (init_gl_state())  ImGui     ,  run().
  */
 static void init(void)
 {
     /*
-     *   Z- ()  .
+     *        ,    (tools/respack).
+     * ,     ,     .
      */
-    glEnable(GL_DEPTH_TEST);    //     
-    glEnable(GL_MULTISAMPLE);   //   -
+    if (cg::open_archive("resources.cgpak") == false)
+        std::cout << "Resource archive not found, using loose files." << std::endl;
+
+    cg::init_thread_pool();     //     
+
+    g_robot = load_robot();
+    for (const char* path : body_texture_paths)
+        cg::preload_texture(path);      //    load_texture()
+}
+
+/*
+ *         (-    ).
+ *     ,         .
+ */
+static float screen_size(const glm::mat4& model, const glm::vec3& size)
+{
+    const float extent = std::max(glm::length(glm::vec3(model[0])) * size.x,
+        glm::length(glm::vec3(model[1])) * size.y);
+    const float distance = std::max(glm::length(glm::vec3(model[3]) - cg::camera.eye), cg::perspective.z_near);
+    const float focal = cg::get_scene_resolution().y / (2.0f * std::tan(cg::perspective.fov / 2.0f));
+    return extent * focal / distance;
+}
+
+/*
+ * , -     ( ),   .
+ */
+constexpr float lod_min_pixels = 0.5f;
+
+/*
+ *      .
+ *     ( load_part_mesh())  ,   ,
+ *        .
+ *        -     flush_draws().
+ *   OpenGL     ,       .
+ */
+static void draw_cuboid(const glm::vec3& size, RobotPart part)
+{
+    cg::CommandList& list = *g_recording;
+    unsigned int material = g_palette_base + g_team * PART_COUNT + part;
+    unsigned int variant = part_variant(part);
 
     /*
-     *    (blending).
+     *           .
+     *         ,    .
      */
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  //   
-    glEnable(GL_BLEND);     //   blending
-
-    unsigned int vbo = init_vbo();  //   VBO
-    unsigned int vao = init_vao();  //   VAO
-    unsigned int texture = init_texture("resources/textures/tu_white.png");     //   
+    if (cg::lighting.robot_lights && (part == PART_EYE || part == PART_ANTENNA))
+    {
+        cg::PointLight light;
+        light.position = glm::vec3(g_model * glm::vec4(0.0f, part == PART_ANTENNA ? size.y / 2 : 0.0f, 0.0f, 1.0f));
+        light.radius = cg::lighting.radius;
+        light.color = glm::vec3(cg::get_material(material).color);
+        light.intensity = cg::lighting.intensity;
+        list.lights.push_back(light);
+    }
 
-    std::cout << "Data init check:" << std::endl;
-    if (gl_print_error() != 0)   //   
+    const float pixels = screen_size(g_model, size);
+    if (pixels < lod_min_pixels)
         return;
 
-    unsigned int program = init_program("resources/shaders/tex_v.glsl",     //   
-        "resources/shaders/tex_f.glsl");
+    if (variant & cg::SHADER_TEXTURED)
+        list.texture_uses.push_back({ cg::get_material(material).texture, pixels });
 
-    if (program == 0)
+    /*
+     *              
+     *      (    ).
+     */
+    glm::mat4 model = glm::scale(g_model, size);
+    unsigned int mesh = g_part_meshes[part];
+    if (mesh != g_cube_mesh)
     {
-        std::cerr << "Failed to compile shaders." << std::endl;
-        return;
+        model = model * g_part_fits[part];
+        mesh = cg::select_mesh_lod(mesh, pixels);
     }
 
-    glUseProgram(program);
-    g_program = program;
+    const bool translucent = cg::get_material(material).color.a < 1.0f;
+    const float depth = glm::length(glm::vec3(g_model[3]) - cg::camera.eye) / cg::perspective.z_far;
+    const uint64_t key = cg::make_sort_key(cg::PASS_SCENE, translucent, variant, material, mesh, depth);
+    cg::record_draw(list, key, mesh, { model, material, { 0, 0, 0 } });
+}
+
+/*
+ *   glMultiDrawElementsIndirect() (    OpenGL).
+ * first_index         ,  base_vertex -
+ *    . Vertex     base_vertex  gl_VertexID.
+ */
+struct DrawElementsCommand
+{
+    uint32_t count;
+    uint32_t instance_count;
+    uint32_t first_index;
+    uint32_t base_vertex;
+    uint32_t base_instance;
+};
+
+/*
+ *       (  ).
+ *    :   (    ,  )
+ *  ,           Z-.
+ *            multi-draw
+ *  -          .
+ * ,         SSBO,
+ *        VAO,   uniform .
+ */
+static void flush_draws(const cg::CommandList& commands)
+{
+    cg::submit_command_list_state(commands);    //    
+
+    g_queue.resize(commands.packets.size());
+    for (size_t i = 0; i < commands.packets.size(); i++)
+        g_queue[i] = { commands.packets[i].key, static_cast<uint32_t>(i) };
+    cg::sort_render_queue(g_queue);
 
     /*
-	*        .
-    */
-    set_model(program);
-    set_view(program);
-    set_projection(program);
+     *            ,
+     *           .
+     */
+    const cg::StreamAllocation instances = cg::allocate_stream(GL_SHADER_STORAGE_BUFFER,
+        commands.instances.size() * sizeof(cg::DrawInstance));
+    if (instances.data == nullptr)
+        g_queue.clear();    //   (      )
+
+    cg::DrawInstance* output = static_cast<cg::DrawInstance*>(instances.data);
+    for (const cg::RenderItem& item : g_queue)
+    {
+        const cg::DrawPacket& packet = commands.packets[item.index];
+        output = std::copy_n(commands.instances.begin() + packet.first_instance, packet.instance_count, output);
+    }
+    if (instances.data != nullptr)
+        cg::bind_buffer_range(GL_SHADER_STORAGE_BUFFER, cg::INSTANCE_BINDING,
+            instances.buffer, instances.offset, instances.size);
+
+    cg::upload_materials();
 
     /*
-	 *     .
+     *       ,  fragment    .
+     */
+    const glm::mat4 view = glm::lookAt(cg::camera.eye, cg::camera.center, cg::camera.up);
+    const glm::mat4 projection = glm::perspective(cg::perspective.fov, cg::perspective.aspect,
+        cg::perspective.z_near, cg::perspective.z_far);
+    const glm::ivec2 resolution = cg::get_scene_resolution();
+    cg::update_lighting(view, projection, cg::perspective.z_near, cg::perspective.z_far,
+        resolution.x, resolution.y);
+
+    /*
+     * Bindless     handle      .
+     *           unit 0.
+     */
+    if (cg::has_bindless_textures() == false)
+        cg::bind_texture(0, GL_TEXTURE_2D_ARRAY, cg::get_texture_array());
+
+    /*
+     *       - -     .
      */
-    set_light_pos(program);
-    set_light_color(program);
+    const cg::StreamAllocation draws = cg::allocate_stream(GL_DRAW_INDIRECT_BUFFER,
+        g_queue.size() * sizeof(DrawElementsCommand));
+    if (draws.data == nullptr)
+        g_queue.clear();
+    else
+        cg::bind_buffer(GL_DRAW_INDIRECT_BUFFER, draws.buffer);
+
+    cg::bind_meshes();
+
+    DrawElementsCommand* draw_commands = static_cast<DrawElementsCommand*>(draws.data);
+    size_t command_count = 0;   //  
+    size_t first = 0;           //    
+    size_t first_instance = 0;  // ,     
+    while (first < g_queue.size())
+    {
+        const cg::DrawPacket& packet = commands.packets[g_queue[first].index];
+        const bool translucent = cg::is_translucent_key(packet.key);
+        const unsigned int variant = cg::get_key_program(packet.key);
+        auto same_batch = [&](const cg::DrawPacket& next)
+            {
+                return cg::is_translucent_key(next.key) == translucent && cg::get_key_program(next.key) == variant;
+            };
+
+        const size_t first_command = command_count;
+        size_t last = first;
+        while (last < g_queue.size() && same_batch(commands.packets[g_queue[last].index]))
+        {
+            //       -  
+            const unsigned int mesh = commands.packets[g_queue[last].index].mesh;
+            const cg::MeshRange& range = cg::get_mesh(mesh);
+            DrawElementsCommand command = { range.index_count, 0, range.first_index, range.base_vertex,
+                static_cast<uint32_t>(first_instance) };
+
+            while (last < g_queue.size())
+            {
+                const cg::DrawPacket& next = commands.packets[g_queue[last].index];
+                if (same_batch(next) == false || next.mesh != mesh)
+                    break;
+
+                command.instance_count += next.instance_count;
+                last++;
+            }
+
+            first_instance += command.instance_count;
+            draw_commands[command_count++] = command;     //   -    GPU
+        }
+
+        cg::set_capability(GL_BLEND, translucent);
+        cg::set_depth_mask(translucent == false);      //      
+
+        unsigned int program = cg::get_program(g_variant_programs[variant]);
+        if (program != 0)   //    
+        {
+            use_program(program, variant);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                reinterpret_cast<const void*>(draws.offset + first_command * sizeof(DrawElementsCommand)),
+                static_cast<int>(command_count - first_command), 0);
+        }
+
+        first = last;
+    }
+
+    cg::set_capability(GL_BLEND, false);
+    cg::set_depth_mask(true);   // glClear()  Z-   
 }
 
 /*
- *      .
+ *    (, , )  model.
  */
-static void draw_cuboid(const glm::vec3& size)
+static glm::mat4 robot_transform(const glm::mat4& model)
 {
-    glm::mat4 original_model = g_model;
-    g_model = glm::scale(g_model, size);
-    set_model(g_program);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    g_model = original_model;
+    glm::mat4 result = glm::translate(model, cg::robot.position);
+    result = glm::rotate(result, glm::radians(cg::robot.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    result = glm::rotate(result, glm::radians(cg::robot.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    result = glm::rotate(result, glm::radians(cg::robot.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    return glm::scale(result, cg::robot.scale);
+}
+
+/*
+ *        (xyz - , w - ).
+ *    ,    -  .   ,
+ *        .
+ */
+static glm::vec4 robot_bounds(void)
+{
+    const float bottom = -(cg::robot.leg_size.y + cg::robot.shin_size.y);
+    const float top = cg::robot.hip_size.y + cg::robot.body_size.y + cg::robot.shoulder_size.y +
+        cg::robot.head_size.y + cg::robot.antenna_size.y;
+    const float half_width = cg::robot.body_size.x * 1.1f / 2 + cg::robot.arm_size.x;
+    const float reach = std::max(cg::robot.body_size.z, cg::robot.head_size.z) / 2 +
+        cg::robot.arm_size.y + cg::robot.forearm_size.y;
+
+    return glm::vec4(0.0f, (top + bottom) / 2, 0.0f,
+        glm::length(glm::vec3(half_width, (top - bottom) / 2, reach)));
+}
+
+/*
+ *      (ax + by + cz + d >= 0 ), 
+ *   view * projection.
+ */
+static std::array<glm::vec4, 6> frustum_planes(const glm::mat4& view_projection)
+{
+    const glm::mat4 rows = glm::transpose(view_projection);
+    std::array<glm::vec4, 6> planes = {
+        rows[3] + rows[0], rows[3] - rows[0],
+        rows[3] + rows[1], rows[3] - rows[1],
+        rows[3] + rows[2], rows[3] - rows[2]
+    };
+    for (glm::vec4& plane : planes)
+        plane /= glm::length(glm::vec3(plane));
+    return planes;
+}
+
+static bool is_sphere_visible(const std::array<glm::vec4, 6>& planes, const glm::vec3& center, float radius)
+{
+    for (const glm::vec4& plane : planes)
+    {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
 }
 
 /*
@@ -713,20 +1073,16 @@ static void draw_robot()
     glm::mat4 original_model = g_model;
 
 	//   
-    g_model = glm::translate(g_model, cg::robot.position);
-    g_model = glm::rotate(g_model, glm::radians(cg::robot.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    g_model = glm::rotate(g_model, glm::radians(cg::robot.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-    g_model = glm::rotate(g_model, glm::radians(cg::robot.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-    g_model = glm::scale(g_model, cg::robot.scale);
+    g_model = robot_transform(g_model);
 
 	//  (   )
     g_model = glm::translate(g_model, glm::vec3(0.0f, cg::robot.hip_size.y / 2, 0.0f));
-    draw_cuboid(cg::robot.hip_size);
+    draw_cuboid(cg::robot.hip_size, PART_HIP);
 
 	//  (   )
     glm::mat4 hips_model = g_model;
     g_model = glm::translate(g_model, glm::vec3(0.0f, cg::robot.hip_size.y / 2 + cg::robot.body_size.y / 2, 0.0f));
-    draw_cuboid(cg::robot.body_size);
+    draw_cuboid(cg::robot.body_size, PART_BODY);
 
 	//  (   )
     glm::mat4 body_model = g_model;
@@ -736,27 +1092,27 @@ static void draw_robot()
         cg::robot.shoulder_size.y,
 		cg::robot.body_size.z * 0.8f
     );
-    draw_cuboid(shoulder_draw_size);
+    draw_cuboid(shoulder_draw_size, PART_SHOULDER);
 
 	//  (   )
     glm::mat4 shoulders_model = g_model;
     g_model = glm::translate(g_model, glm::vec3(0.0f, cg::robot.shoulder_size.y / 2 + cg::robot.head_size.y / 2, 0.0f));
-    draw_cuboid(cg::robot.head_size);
+    draw_cuboid(cg::robot.head_size, PART_HEAD);
 
 	// 
     glm::mat4 head_model = g_model;
     g_model = glm::translate(g_model, glm::vec3(cg::robot.head_size.x / 4, cg::robot.head_size.y / 4, cg::robot.head_size.z / 2 + cg::robot.eye_size.z / 2));;
-    draw_cuboid(cg::robot.eye_size);
+    draw_cuboid(cg::robot.eye_size, PART_EYE);
 
     g_model = head_model;
     g_model = glm::translate(g_model, glm::vec3(-cg::robot.head_size.x / 4, cg::robot.head_size.y / 4, cg::robot.head_size.z / 2 + cg::robot.eye_size.z / 2));
-    draw_cuboid(cg::robot.eye_size);
+    draw_cuboid(cg::robot.eye_size, PART_EYE);
 
 	// 
     g_model = head_model;
     g_model = glm::translate(g_model, glm::vec3(0.0f, cg::robot.head_size.y / 2 + cg::robot.antenna_size.y / 2, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(cg::robot.antenna_wiggle), glm::vec3(0.0f, 0.0f, 1.0f));
-    draw_cuboid(cg::robot.antenna_size);
+    draw_cuboid(cg::robot.antenna_size, PART_ANTENNA);
 
     //  
     g_model = shoulders_model;
@@ -764,12 +1120,12 @@ static void draw_robot()
         0.0f, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(cg::robot.arm_swing), glm::vec3(1.0f, 0.0f, 0.0f));
     g_model = glm::translate(g_model, glm::vec3(0.0f, -cg::robot.arm_size.y / 2, 0.0f));
-    draw_cuboid(cg::robot.arm_size);
+    draw_cuboid(cg::robot.arm_size, PART_ARM);
 
 	//  
     g_model = glm::translate(g_model, glm::vec3(0.0f, -cg::robot.arm_size.y / 2 - cg::robot.forearm_size.y / 2, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(cg::robot.forearm_swing), glm::vec3(1.0f, 0.0f, 0.0f));
-    draw_cuboid(cg::robot.forearm_size);
+    draw_cuboid(cg::robot.forearm_size, PART_FOREARM);
 
 	//  
     g_model = shoulders_model;
@@ -777,36 +1133,36 @@ static void draw_robot()
         0.0f, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(-cg::robot.arm_swing), glm::vec3(1.0f, 0.0f, 0.0f));
     g_model = glm::translate(g_model, glm::vec3(0.0f, -cg::robot.arm_size.y / 2, 0.0f));
-    draw_cuboid(cg::robot.arm_size);
+    draw_cuboid(cg::robot.arm_size, PART_ARM);
 
 	//  
     g_model = glm::translate(g_model, glm::vec3(0.0f, -cg::robot.arm_size.y / 2 - cg::robot.forearm_size.y / 2, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(-cg::robot.forearm_swing), glm::vec3(1.0f, 0.0f, 0.0f));
-    draw_cuboid(cg::robot.forearm_size);
+    draw_cuboid(cg::robot.forearm_size, PART_FOREARM);
 
 	//  
     g_model = hips_model;
     g_model = glm::translate(g_model, glm::vec3(-cg::robot.hip_size.x / 4,
         -cg::robot.hip_size.y / 2 - cg::robot.leg_size.y / 2, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(-cg::robot.leg_swing), glm::vec3(1.0f, 0.0f, 0.0f));
-    draw_cuboid(cg::robot.leg_size);
+    draw_cuboid(cg::robot.leg_size, PART_LEG);
 
 	//  
     g_model = glm::translate(g_model, glm::vec3(0.0f, -cg::robot.leg_size.y / 2 - cg::robot.shin_size.y / 2, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(-cg::robot.shin_swing), glm::vec3(1.0f, 0.0f, 0.0f));
-    draw_cuboid(cg::robot.shin_size);
+    draw_cuboid(cg::robot.shin_size, PART_SHIN);
 
 	//  
     g_model = hips_model;
     g_model = glm::translate(g_model, glm::vec3(cg::robot.hip_size.x / 4,
         -cg::robot.hip_size.y / 2 - cg::robot.leg_size.y / 2, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(cg::robot.leg_swing), glm::vec3(1.0f, 0.0f, 0.0f));
-    draw_cuboid(cg::robot.leg_size);
+    draw_cuboid(cg::robot.leg_size, PART_LEG);
 
 	//  
     g_model = glm::translate(g_model, glm::vec3(0.0f, -cg::robot.leg_size.y / 2 - cg::robot.shin_size.y / 2, 0.0f));
     g_model = glm::rotate(g_model, glm::radians(cg::robot.shin_swing), glm::vec3(1.0f, 0.0f, 0.0f));
-    draw_cuboid(cg::robot.shin_size);
+    draw_cuboid(cg::robot.shin_size, PART_SHIN);
 
     g_model = original_model;
 }
@@ -843,23 +1199,83 @@ static void draw_starfield_background()
  */
 static void render(void)
 {
-	//     
+	//      (        )
     static float time = 0.0f;
-	time += 0.05f;  //   -  ( 0.1)
+    if (cg::robot.walking)
+    {
+		time += 0.05f;  //   -  ( 0.1)
+
+		//     
+        cg::robot.arm_swing = sin(time * cg::robot.walk_speed) * 30.0f;
+        cg::robot.leg_swing = sin(time * cg::robot.walk_speed) * 25.0f;
+
+		//     -     
+        cg::robot.forearm_swing = sin(time * cg::robot.walk_speed * 0.8f) * 15.0f;  
+        cg::robot.shin_swing = sin(time * cg::robot.walk_speed * 0.7f) * 20.0f;     
 
-	//     
-    cg::robot.arm_swing = sin(time * cg::robot.walk_speed) * 30.0f;
-    cg::robot.leg_swing = sin(time * cg::robot.walk_speed) * 25.0f;
+		//   
+        cg::robot.head_bob = sin(time * cg::robot.walk_speed * 2.0f) * 3.0f;
+        cg::robot.antenna_wiggle = sin(time * cg::robot.walk_speed * 3.0f) * 10.0f;
+    }
+
+    /*
+     *      .
+     *    ,        .
+     *
+     *     ,        .
+     *           
+     *     . OpenGL      ,
+     *     flush_draws().
+     */
+    constexpr int robots_per_slice = 64;    // -     
+
+    const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(cg::crowd.count)))));
+    const int teams = std::clamp(cg::crowd.teams, 1, team_count);
+    const int robots = g_robot.is_ready() && g_robot.get() ? cg::crowd.count + 1 : 0;     //   
+    const int slices = std::clamp((robots + robots_per_slice - 1) / robots_per_slice,
+        1, static_cast<int>(cg::get_thread_count()) + 1);
+    g_slices.resize(slices);
+
+    const glm::mat4 view = glm::lookAt(cg::camera.eye, cg::camera.center, cg::camera.up);
+    const glm::mat4 projection = glm::perspective(cg::perspective.fov, cg::perspective.aspect,
+        cg::perspective.z_near, cg::perspective.z_far);
+    const std::array<glm::vec4, 6> planes = frustum_planes(projection * view);
+
+    //       ,      
+    const glm::vec4 bounds = robot_bounds();
+    const float scale = std::max({ cg::robot.scale.x, cg::robot.scale.y, cg::robot.scale.z });
+    const float radius = bounds.w * scale + (cg::lighting.robot_lights ? cg::lighting.radius : 0.0f);
+
+    cg::parallel_for(slices, [&](int slice)
+    {
+        g_recording = &g_slices[slice];
 
-	//     -     
-    cg::robot.forearm_swing = sin(time * cg::robot.walk_speed * 0.8f) * 15.0f;  
-    cg::robot.shin_swing = sin(time * cg::robot.walk_speed * 0.7f) * 20.0f;     
+        const int first = robots * slice / slices;
+        const int last = robots * (slice + 1) / slices;
+        for (int i = first; i < last; i++)
+        {
+            g_model = glm::mat4(1.0f);
+            if (i > 0)  //       
+            {
+                g_model = glm::translate(g_model, glm::vec3(
+                    ((i - 1) % columns - columns / 2) * cg::crowd.spacing,
+                    0.0f,
+                    -(1 + (i - 1) / columns) * cg::crowd.spacing));
+            }
+
+            const glm::vec3 center = glm::vec3(robot_transform(g_model) * glm::vec4(glm::vec3(bounds), 1.0f));
+            if (is_sphere_visible(planes, center, radius) == false)
+                continue;
+
+            g_team = i % teams;
+            draw_robot();
+        }
 
-	//   
-    cg::robot.head_bob = sin(time * cg::robot.walk_speed * 2.0f) * 3.0f;
-    cg::robot.antenna_wiggle = sin(time * cg::robot.walk_speed * 3.0f) * 10.0f;
+        g_recording = nullptr;
+    });
 
-    draw_robot();
+    cg::merge_command_lists(g_slices, g_frame_commands);
+    flush_draws(g_frame_commands);
 }
 
 /*
@@ -867,34 +1283,92 @@ static void render(void)
  */
 static void run(void)
 {
+    init();     //      ,    
+
     GLFWwindow* window = init_window();
     if (window == nullptr)
+    {
+        cg::cleanup_thread_pool();
         std::exit(1);
+    }
 
+    if (init_gl_state() == false)
+    {
+        std::cerr << "Initialization failed." << std::endl;
+        cg::cleanup_thread_pool();
+        cleanup_window(window);
+        std::exit(1);
+    }
     cg::init_ImGui(window);
-    init();
+    cg::start_shader_watcher("resources/shaders");     //      (   )
 
     /*
 	 *  
      */
     while (glfwWindowShouldClose(window) == 0)
     {
-        glfwPollEvents();
+        /*
+         *      ,       ( redraw.h).
+         *   ,        .
+         */
+        const bool on_demand = cg::redraw.on_demand && cg::robot.walking == false;
+        if (on_demand)
+            cg::wait_for_redraw(cg::redraw.idle_timeout);
+        else
+            glfwPollEvents();
+
+        /*
+         *      -    ( ,
+         *     )    .
+         */
+        const bool redraw = on_demand == false || cg::consume_redraw();
+
+        cg::update_programs();      //      
+        cg::update_textures(redraw);    //        
+        cg::update_async();         //   ,   
+
+        if (redraw == false)
+            continue;       //     -     
 
         cg::render_ImGui();
+        if (cg::is_ImGui_active())
+            cg::request_redraw();   //     .. -      
+
+        /*
+         *            
+         *    .        .
+         */
+        cg::begin_stream_frame();   //  GPU     
+        cg::begin_scene_target(cg::window.window_width, cg::window.window_height);
 
         clear();
 
         render();
 
+        cg::end_scene_target();
+        cg::end_stream_frame();
+
         cg::display_ImGui();
 
         glfwSwapBuffers(window);
+        cg::finish_gl_state_frame();
     }
 
     /*
 	 *  
      */
+    cg::stop_shader_watcher();
+    cg::cleanup_thread_pool();      //   -  
+    cg::cleanup_async();            //    
+    cg::cleanup_assets();
+    cg::cleanup_textures();
+    cg::cleanup_shaders();
+    cg::cleanup_materials();
+    cg::cleanup_lighting();
+    cg::cleanup_scene_target();
+    cg::cleanup_stream_buffer();
+    cg::cleanup_meshes();
+    cg::close_archive();
     cg::cleanup_ImGui();
     cleanup_window(window);
 }
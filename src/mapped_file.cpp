@@ -0,0 +1,127 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cg
+{
+#ifdef _WIN32
+    /*
+     *      (Windows).
+     * Handle-      -    .
+     */
+    bool map_file(const std::string& path, MappedFile& file)
+    {
+        HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(handle, &size) == FALSE || size.QuadPart == 0)
+        {
+            CloseHandle(handle);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(handle);
+        if (mapping == nullptr)
+            return false;
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            return false;
+        }
+
+        file.data = static_cast<const unsigned char*>(data);
+        file.size = static_cast<size_t>(size.QuadPart);
+        file.handle = mapping;
+        return true;
+    }
+
+    /*
+     *   .
+     */
+    void unmap_file(MappedFile& file)
+    {
+        if (file.data != nullptr)
+            UnmapViewOfFile(file.data);
+        if (file.handle != nullptr)
+            CloseHandle(file.handle);
+
+        file = MappedFile();
+    }
+
+    /*
+     *       .
+     * PrefetchVirtualMemory    Windows 8  -  -    .
+     */
+    void prefetch_file(const MappedFile& file)
+    {
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+        WIN32_MEMORY_RANGE_ENTRY range = { const_cast<unsigned char*>(file.data), file.size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        (void)file;
+#endif
+    }
+#else
+    /*
+     *      (POSIX).
+     *     -   .
+     */
+    bool map_file(const std::string& path, MappedFile& file)
+    {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+            return false;
+
+        struct stat info;
+        if (fstat(fd, &info) == -1 || info.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            return false;
+
+        file.data = static_cast<const unsigned char*>(data);
+        file.size = static_cast<size_t>(info.st_size);
+        file.handle = nullptr;
+        return true;
+    }
+
+    /*
+     *   .
+     */
+    void unmap_file(MappedFile& file)
+    {
+        if (file.data != nullptr)
+            munmap(const_cast<unsigned char*>(file.data), file.size);
+
+        file = MappedFile();
+    }
+
+    /*
+     *        (  ).
+     */
+    void prefetch_file(const MappedFile& file)
+    {
+        if (file.data != nullptr)
+            madvise(const_cast<unsigned char*>(file.data), file.size, MADV_WILLNEED);
+    }
+#endif
+
+} // namespace cg
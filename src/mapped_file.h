@@ -0,0 +1,27 @@
+#ifndef CG_MAPPED_FILE
+#define CG_MAPPED_FILE
+
+#include <cstddef>
+#include <string>
+
+namespace cg
+{
+
+/*
+ * ,    (memory-mapped)   .
+ *         .
+ */
+struct MappedFile
+{
+    const unsigned char* data = nullptr;    //   
+    size_t size = 0;                        //   
+    void* handle = nullptr;                 // - 
+};
+
+bool map_file(const std::string& path, MappedFile& file);
+void unmap_file(MappedFile& file);
+void prefetch_file(const MappedFile& file);
+
+} // namespace cg
+
+#endif
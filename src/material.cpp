@@ -0,0 +1,113 @@
+#include "glad/glad.h"
+
+#include "material.h"
+#include "gl_state.h"
+#include "stream_buffer.h"
+#include "texture.h"
+
+#include <cstring>
+#include <vector>
+
+namespace cg
+{
+    /*
+     *   ,     SSBO (std430, 48 ).
+     */
+    struct GpuMaterial
+    {
+        glm::vec4 color;
+        float emissive;
+        float specular_strength;
+        float shininess;
+        unsigned int texture_layer;     //     
+        glm::uvec2 texture_handle;      // Bindless handle (,  32 )
+        glm::uvec2 padding;
+    };
+
+    static std::vector<Material> g_materials;   //       CPU
+    static std::vector<GpuMaterial> g_gpu_materials;   //   handle/  ,   
+    static bool g_dirty = false;                //      
+    static int g_texture_generation = -1;       // get_textures_generation()   
+
+    static_assert(sizeof(GpuMaterial) == 48, "GpuMaterial must match the std430 layout in the shaders");
+
+    /*
+     *     -       .
+     */
+    void init_materials(void)
+    {
+        g_dirty = true;
+        g_texture_generation = -1;
+    }
+
+    /*
+     *     .
+     *  ,       .
+     */
+    unsigned int add_material(const Material& material)
+    {
+        g_materials.push_back(material);
+        g_dirty = true;
+        return static_cast<unsigned int>(g_materials.size()) - 1;
+    }
+
+    /*
+     *     .
+     */
+    const Material& get_material(unsigned int index)
+    {
+        return g_materials.at(index);
+    }
+
+    /*
+     *       ( begin_stream_frame()  end_stream_frame()).
+     *   handle/          
+     *       (  handle  ).  
+     *      ,    ,  GPU    .
+     */
+    void upload_materials(void)
+    {
+        if (g_materials.empty())
+            return;
+
+        const int texture_generation = get_textures_generation();
+        if (g_dirty || texture_generation != g_texture_generation)
+        {
+            g_gpu_materials.resize(g_materials.size());
+            for (size_t i = 0; i < g_materials.size(); i++)
+            {
+                const Material& material = g_materials[i];
+                const uint64_t handle = get_texture_handle(material.texture);
+
+                GpuMaterial& gpu = g_gpu_materials[i];
+                gpu.color = material.color;
+                gpu.emissive = material.emissive;
+                gpu.specular_strength = material.specular_strength;
+                gpu.shininess = material.shininess;
+                gpu.texture_layer = get_texture_layer(material.texture);
+                gpu.texture_handle = glm::uvec2(static_cast<unsigned int>(handle), static_cast<unsigned int>(handle >> 32));
+                gpu.padding = glm::uvec2(0);
+            }
+
+            g_dirty = false;
+            g_texture_generation = texture_generation;
+        }
+
+        const StreamAllocation allocation = allocate_stream(GL_SHADER_STORAGE_BUFFER,
+            g_gpu_materials.size() * sizeof(GpuMaterial));
+        if (allocation.data == nullptr)
+            return;
+        std::memcpy(allocation.data, g_gpu_materials.data(), allocation.size);
+        bind_buffer_range(GL_SHADER_STORAGE_BUFFER, MATERIAL_BINDING, allocation.buffer, allocation.offset, allocation.size);
+    }
+
+    /*
+     *   .
+     */
+    void cleanup_materials(void)
+    {
+        g_materials.clear();
+        g_gpu_materials.clear();
+    }
+
+} // namespace cg
@@ -0,0 +1,34 @@
+#ifndef CG_MATERIAL
+#define CG_MATERIAL
+
+#include <glm/glm.hpp>
+
+namespace cg
+{
+
+/*
+ *   .
+ *       bindless handle      
+ * ( GpuMaterial  material.cpp  struct Material  ).
+ */
+struct Material
+{
+    glm::vec4 color = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);   //  (RGBA)
+    float emissive = 0.0f;              // 1.0 -  , 0.0 - 
+    float specular_strength = 0.3f;     //    
+    float shininess = 16.0f;            //   
+    int texture = -1;                   //   load_texture()  -1 ( )
+};
+
+constexpr unsigned int MATERIAL_BINDING = 0;    // Binding   SSBO  
+constexpr unsigned int INSTANCE_BINDING = 1;    // Binding   SSBO  
+
+void init_materials(void);
+unsigned int add_material(const Material& material);
+const Material& get_material(unsigned int index);
+void upload_materials(void);
+void cleanup_materials(void);
+
+} // namespace cg
+
+#endif
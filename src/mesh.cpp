@@ -0,0 +1,154 @@
+#include "glad/glad.h"
+
+#include "mesh.h"
+#include "gl_resource.h"
+#include "gl_state.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace cg
+{
+    /*
+     *         :   .
+     *     - vertex      gl_VertexID
+     * (programmable vertex pulling).        VAO,
+     *         GPU    .
+     *            
+     *       multi-draw ,    VAO  .
+     *
+     *       (base_vertex    ),
+     *       -      .cgmesh .
+     */
+    static std::vector<MeshRange> g_meshes;
+
+    static GlBuffer g_vertex_buffer;
+    static GlBuffer g_index_buffer;
+    static size_t g_vertex_count = 0;               //    
+    static size_t g_index_count = 0;
+    static size_t g_vertex_capacity = 0;            //     
+    static size_t g_index_capacity = 0;
+    static GlVertexArray g_empty_vao;               // Core   VAO   
+
+    constexpr size_t min_vertex_capacity = 4096;
+    constexpr size_t min_index_capacity = 16384;
+
+    /*
+     *      ,          .
+     */
+    constexpr float lod_error_pixels = 1.0f;
+
+    static_assert(sizeof(MeshVertex) == 32, "MeshVertex must match the std430 layout in tex_v.glsl");
+
+    void init_meshes(void)
+    {
+        g_empty_vao = GlVertexArray::create();
+    }
+
+    /*
+     *     required .     ,
+     *       (   -)   
+     *    GPU.  true,    .
+     */
+    static bool reserve_buffer(GlBuffer& buffer, size_t& capacity, size_t used, size_t required,
+        size_t min_capacity, size_t element_size)
+    {
+        if (required <= capacity)
+            return false;
+
+        size_t grown_capacity = std::max(capacity * 2, min_capacity);
+        while (grown_capacity < required)
+            grown_capacity *= 2;
+
+        GlBuffer grown(grown_capacity * element_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        if (used > 0)
+            grown.copy_from(buffer, used * element_size);
+        buffer = std::move(grown);
+        capacity = grown_capacity;
+        return true;
+    }
+
+    /*
+     *         ( lods -     ).
+     *    ,    -        .
+     *     ;      .
+     *       init_meshes().
+     */
+    unsigned int add_mesh(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices,
+        std::span<const MeshLod> lods)
+    {
+        reserve_buffer(g_vertex_buffer, g_vertex_capacity, g_vertex_count,
+            g_vertex_count + vertices.size(), min_vertex_capacity, sizeof(MeshVertex));
+        const bool grown_indices = reserve_buffer(g_index_buffer, g_index_capacity, g_index_count,
+            g_index_count + indices.size(), min_index_capacity, sizeof(uint32_t));
+        if (grown_indices)
+            g_empty_vao.set_element_buffer(g_index_buffer);     //       
+
+        if (vertices.empty() == false)
+            g_vertex_buffer.update(g_vertex_count * sizeof(MeshVertex), vertices.size_bytes(), vertices.data());
+        if (indices.empty() == false)
+            g_index_buffer.update(g_index_count * sizeof(uint32_t), indices.size_bytes(), indices.data());
+
+        const MeshLod whole = { 0, static_cast<uint32_t>(indices.size()), 0.0f };
+        if (lods.empty())
+            lods = std::span<const MeshLod>(&whole, 1);
+
+        const unsigned int first_mesh = static_cast<unsigned int>(g_meshes.size());
+        for (size_t lod = 0; lod < lods.size(); lod++)
+        {
+            MeshRange range;
+            range.first_index = static_cast<unsigned int>(g_index_count + lods[lod].first_index);
+            range.index_count = lods[lod].index_count;
+            range.base_vertex = static_cast<unsigned int>(g_vertex_count);
+            range.lod_count = static_cast<unsigned int>(lods.size() - lod);
+            range.lod_error = lods[lod].error;
+            g_meshes.push_back(range);
+        }
+
+        g_vertex_count += vertices.size();
+        g_index_count += indices.size();
+        return first_mesh;
+    }
+
+    const MeshRange& get_mesh(unsigned int mesh)
+    {
+        return g_meshes.at(mesh);
+    }
+
+    /*
+     * -   ,       lod_error_pixels,
+     *     pixels .           .
+     */
+    unsigned int select_mesh_lod(unsigned int mesh, float pixels)
+    {
+        const unsigned int lod_count = g_meshes[mesh].lod_count;
+        unsigned int selected = mesh;
+        for (unsigned int lod = 1; lod < lod_count; lod++)
+        {
+            if (g_meshes[mesh + lod].lod_error * pixels > lod_error_pixels)
+                break;
+            selected = mesh + lod;
+        }
+        return selected;
+    }
+
+    /*
+     *        VAO (   )  .
+     */
+    void bind_meshes(void)
+    {
+        bind_buffer_base(GL_SHADER_STORAGE_BUFFER, VERTEX_BINDING, g_vertex_buffer.id());
+        bind_vertex_array(g_empty_vao.id());
+    }
+
+    void cleanup_meshes(void)
+    {
+        g_empty_vao.reset();
+        g_vertex_buffer.reset();
+        g_index_buffer.reset();
+        g_vertex_count = g_index_count = 0;
+        g_vertex_capacity = g_index_capacity = 0;
+        g_meshes.clear();
+    }
+
+} // namespace cg
@@ -0,0 +1,60 @@
+#ifndef CG_MESH
+#define CG_MESH
+
+#include <cstdint>
+#include <span>
+#include <glm/glm.hpp>
+
+namespace cg
+{
+
+/*
+ *   ,      SSBO (std430, 32 ).
+ *    struct Vertex  tex_v.glsl.
+ */
+struct MeshVertex
+{
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 tex_coord;
+};
+
+/*
+ *      .
+ *       -    glDraw*Elements*()
+ *  first_index  base_vertex,  vertex     gl_VertexID ( tex_v.glsl).
+ *          ( select_mesh_lod()).
+ */
+struct MeshRange
+{
+    unsigned int first_index;
+    unsigned int index_count;
+    unsigned int base_vertex;
+    unsigned int lod_count;     //      ()
+    float lod_error;            //        (0  )
+};
+
+/*
+ *   :     
+ *  -         .
+ */
+struct MeshLod
+{
+    uint32_t first_index;
+    uint32_t index_count;
+    float error;
+};
+
+constexpr unsigned int VERTEX_BINDING = 5;      // Binding   SSBO     
+
+void init_meshes(void);
+unsigned int add_mesh(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices,
+    std::span<const MeshLod> lods = {});
+const MeshRange& get_mesh(unsigned int mesh);
+unsigned int select_mesh_lod(unsigned int mesh, float pixels);
+void bind_meshes(void);
+void cleanup_meshes(void);
+
+} // namespace cg
+
+#endif
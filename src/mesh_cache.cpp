@@ -0,0 +1,305 @@
+#include "mesh_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace cg
+{
+    static size_t align_offset(size_t offset)
+    {
+        return (offset + mesh_file_alignment - 1) & ~static_cast<size_t>(mesh_file_alignment - 1);
+    }
+
+    static uint64_t rotate_left(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static uint64_t read_u64(const unsigned char* p)
+    {
+        uint64_t value;
+        std::memcpy(&value, p, 8);      // Little-endian
+        return value;
+    }
+
+    /*
+     * 64-      XXH64 (  seed).
+     *   32      -  GB/s,
+     *             .
+     */
+    uint64_t hash_mesh_source(std::span<const unsigned char> data)
+    {
+        constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t prime3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t prime5 = 0x27D4EB2F165667C5ull;
+        auto round = [](uint64_t accumulator, uint64_t input)
+            {
+                return rotate_left(accumulator + input * prime2, 31) * prime1;
+            };
+
+        const unsigned char* p = data.data();
+        const unsigned char* const end = p + data.size();
+        uint64_t hash;
+        if (data.size() >= 32)
+        {
+            uint64_t v1 = prime1 + prime2, v2 = prime2, v3 = 0, v4 = 0 - prime1;
+            for (; end - p >= 32; p += 32)
+            {
+                v1 = round(v1, read_u64(p));
+                v2 = round(v2, read_u64(p + 8));
+                v3 = round(v3, read_u64(p + 16));
+                v4 = round(v4, read_u64(p + 24));
+            }
+
+            hash = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+            for (uint64_t v : { v1, v2, v3, v4 })
+                hash = (hash ^ round(0, v)) * prime1 + prime4;
+        }
+        else
+        {
+            hash = prime5;
+        }
+
+        hash += data.size();
+        for (; end - p >= 8; p += 8)
+            hash = rotate_left(hash ^ round(0, read_u64(p)), 27) * prime1 + prime4;
+        if (end - p >= 4)
+        {
+            uint32_t word;
+            std::memcpy(&word, p, 4);
+            hash = rotate_left(hash ^ (word * prime1), 23) * prime2 + prime3;
+            p += 4;
+        }
+        for (; p < end; p++)
+            hash = rotate_left(hash ^ (*p * prime5), 11) * prime1;
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    /*
+     *     .cgmesh     ,  
+     *       .       ,
+     *            . 
+     *       -    .
+     */
+    static bool read_mesh_file(std::span<const unsigned char> data, MeshFile& mesh)
+    {
+        MeshFileHeader header;
+        if (data.size() < sizeof(header))
+            return false;
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        const uint64_t size = data.size();
+        const uint64_t tables_end = sizeof(MeshFileHeader) + uint64_t(header.submesh_count) * sizeof(MeshFileSubmesh) +
+            uint64_t(header.lod_count) * sizeof(MeshFileLod);
+        const uint64_t vertices_size = uint64_t(header.vertex_count) * sizeof(MeshVertex);
+        const uint64_t indices_size = uint64_t(header.index_count) * sizeof(uint32_t);
+        if (std::memcmp(header.magic, mesh_file_magic, 4) != 0 || header.version != mesh_file_version ||
+            header.vertex_size != sizeof(MeshVertex) || header.lod_count == 0 || tables_end > size ||
+            header.vertex_offset % mesh_file_alignment != 0 || header.index_offset % mesh_file_alignment != 0 ||
+            header.vertex_offset < tables_end || header.vertex_offset > size || vertices_size > size - header.vertex_offset ||
+            header.index_offset > size || indices_size > size - header.index_offset)
+            return false;
+
+        const unsigned char* base = data.data();
+        const MeshFileSubmesh* submeshes = reinterpret_cast<const MeshFileSubmesh*>(base + sizeof(MeshFileHeader));
+        const MeshFileLod* lods = reinterpret_cast<const MeshFileLod*>(submeshes + header.submesh_count);
+        auto valid_range = [&header](uint32_t first, uint32_t count)
+            {
+                return first <= header.index_count && count <= header.index_count - first && count % 3 == 0;
+            };
+
+        mesh.lods.clear();
+        for (uint32_t i = 0; i < header.lod_count; i++)
+        {
+            if (valid_range(lods[i].first_index, lods[i].index_count) == false)
+                return false;
+            mesh.lods.push_back({ lods[i].first_index, lods[i].index_count, lods[i].error });
+        }
+        for (uint32_t i = 0; i < header.submesh_count; i++)
+        {
+            if (valid_range(submeshes[i].first_index, submeshes[i].index_count) == false)
+                return false;
+        }
+
+        const uint32_t* indices = reinterpret_cast<const uint32_t*>(base + header.index_offset);
+        uint32_t max_index = 0;
+        for (uint32_t i = 0; i < header.index_count; i++)
+            max_index = std::max(max_index, indices[i]);
+        if (header.index_count > 0 && max_index >= header.vertex_count)
+            return false;
+
+        mesh.vertices = std::span<const MeshVertex>(reinterpret_cast<const MeshVertex*>(base + header.vertex_offset),
+            header.vertex_count);
+        mesh.indices = std::span<const uint32_t>(indices, header.index_count);
+        mesh.submeshes = std::span<const MeshFileSubmesh>(submeshes, header.submesh_count);
+        mesh.bounds_min = glm::vec3(header.bounds_min[0], header.bounds_min[1], header.bounds_min[2]);
+        mesh.bounds_max = glm::vec3(header.bounds_max[0], header.bounds_max[1], header.bounds_max[2]);
+        mesh.source_hash = header.source_hash;
+        mesh.source_size = header.source_size;
+        return true;
+    }
+
+    /*
+     *   .cgmesh    (     ).
+     *   ,  false  .
+     */
+    bool open_mesh_file(const std::string& path, MeshFile& mesh)
+    {
+        close_mesh_file(mesh);
+        if (open_resource(path, mesh.resource) == false)
+            return false;
+
+        if (read_mesh_file(mesh.resource.data, mesh) == false)
+        {
+            std::cerr << "Invalid mesh file " << path << "." << std::endl;
+            close_mesh_file(mesh);
+            return false;
+        }
+        return true;
+    }
+
+    void close_mesh_file(MeshFile& mesh)
+    {
+        close_resource(mesh.resource);
+        mesh = MeshFile();
+    }
+
+    /*
+     *   .cgmesh    ( mesh_format.h).
+     */
+    std::vector<unsigned char> build_mesh_file(const ImportedMesh& mesh, uint64_t source_hash, uint64_t source_size)
+    {
+        MeshFileHeader header = {};
+        std::memcpy(header.magic, mesh_file_magic, 4);
+        header.version = mesh_file_version;
+        header.source_hash = source_hash;
+        header.source_size = source_size;
+        header.vertex_size = sizeof(MeshVertex);
+        header.vertex_count = static_cast<uint32_t>(mesh.vertices.size());
+        header.index_count = static_cast<uint32_t>(mesh.indices.size());
+        header.submesh_count = static_cast<uint32_t>(mesh.submeshes.size());
+        header.lod_count = static_cast<uint32_t>(mesh.lods.size());
+        for (int axis = 0; axis < 3; axis++)
+        {
+            header.bounds_min[axis] = mesh.bounds_min[axis];
+            header.bounds_max[axis] = mesh.bounds_max[axis];
+        }
+
+        const size_t tables_end = sizeof(MeshFileHeader) + mesh.submeshes.size() * sizeof(MeshFileSubmesh) +
+            mesh.lods.size() * sizeof(MeshFileLod);
+        header.vertex_offset = align_offset(tables_end);
+        header.index_offset = align_offset(header.vertex_offset + mesh.vertices.size() * sizeof(MeshVertex));
+
+        std::vector<unsigned char> data(header.index_offset + mesh.indices.size() * sizeof(uint32_t), 0);
+        unsigned char* p = data.data();
+        std::memcpy(p, &header, sizeof(header));
+        p += sizeof(header);
+
+        for (const ImportedSubmesh& submesh : mesh.submeshes)
+        {
+            MeshFileSubmesh entry = {};
+            entry.first_index = submesh.first_index;
+            entry.index_count = submesh.index_count;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                entry.bounds_min[axis] = submesh.bounds_min[axis];
+                entry.bounds_max[axis] = submesh.bounds_max[axis];
+            }
+            std::memcpy(p, &entry, sizeof(entry));
+            p += sizeof(entry);
+        }
+
+        for (const MeshLod& lod : mesh.lods)
+        {
+            const MeshFileLod entry = { lod.first_index, lod.index_count, lod.error, 0 };
+            std::memcpy(p, &entry, sizeof(entry));
+            p += sizeof(entry);
+        }
+
+        std::memcpy(data.data() + header.vertex_offset, mesh.vertices.data(), mesh.vertices.size() * sizeof(MeshVertex));
+        std::memcpy(data.data() + header.index_offset, mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+        return data;
+    }
+
+    /*
+     *      ,        .
+     */
+    static bool write_file(const std::string& path, const std::vector<unsigned char>& data)
+    {
+        const std::string temporary_path = path + ".tmp";
+        {
+            std::ofstream out(temporary_path, std::ios::out | std::ios::binary);
+            out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (out.good() == false)
+                return false;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary_path, path, error);
+        if (error)
+            std::filesystem::remove(temporary_path, error);
+        return !error;
+    }
+
+    /*
+     *    name ( )  name.glb  name.obj,    name.cgmesh.
+     *      (       ),  
+     *  .cgmesh .      import_mesh(),     
+     *   .      .cgmesh ,   .
+     *       .   ,  false  .
+     */
+    bool load_mesh(const std::string& name, MeshFile& mesh)
+    {
+        close_mesh_file(mesh);
+        const std::string cache_path = name + ".cgmesh";
+
+        Resource source;
+        std::string source_path;
+        for (const char* extension : { ".glb", ".obj" })
+        {
+            if (open_resource(name + extension, source))
+            {
+                source_path = name + extension;
+                break;
+            }
+        }
+        if (source_path.empty())
+            return open_mesh_file(cache_path, mesh);
+
+        const uint64_t source_hash = hash_mesh_source(source.data);
+        const uint64_t source_size = source.data.size();
+        close_resource(source);
+
+        if (open_mesh_file(cache_path, mesh) && mesh.source_hash == source_hash && mesh.source_size == source_size)
+        {
+            if (mesh.resource.file.data != nullptr)
+                prefetch_file(mesh.resource.file);     //   ,    
+            return true;
+        }
+        close_mesh_file(mesh);
+
+        ImportedMesh imported;
+        if (import_mesh(source_path, imported) == false)
+            return false;
+        mesh.memory = build_mesh_file(imported, source_hash, source_size);
+
+        if (write_file(cache_path, mesh.memory))
+            std::cout << "Wrote " << cache_path << " (" << mesh.memory.size() / 1024 << " KB)." << std::endl;
+        else
+            std::cerr << "Could not write mesh cache " << cache_path << "." << std::endl;
+        return read_mesh_file(mesh.memory, mesh);
+    }
+
+} // namespace cg
@@ -0,0 +1,45 @@
+#ifndef CG_MESH_CACHE
+#define CG_MESH_CACHE
+
+#include "archive.h"
+#include "mesh.h"
+#include "mesh_format.h"
+#include "mesh_import.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace cg
+{
+
+/*
+ *     .cgmesh ( mesh_format.h).      -
+ *     ,       ,  memory.
+ *    close_mesh_file().
+ */
+struct MeshFile
+{
+    std::span<const MeshVertex> vertices;
+    std::span<const uint32_t> indices;
+    std::span<const MeshFileSubmesh> submeshes;
+    std::vector<MeshLod> lods;
+    glm::vec3 bounds_min = glm::vec3(0.0f);
+    glm::vec3 bounds_max = glm::vec3(0.0f);
+    uint64_t source_hash = 0;
+    uint64_t source_size = 0;
+    Resource resource;                      //  
+    std::vector<unsigned char> memory;      //  ,   
+};
+
+bool load_mesh(const std::string& name, MeshFile& mesh);
+bool open_mesh_file(const std::string& path, MeshFile& mesh);
+void close_mesh_file(MeshFile& mesh);
+std::vector<unsigned char> build_mesh_file(const ImportedMesh& mesh, uint64_t source_hash, uint64_t source_size);
+uint64_t hash_mesh_source(std::span<const unsigned char> data);
+
+} // namespace cg
+
+#endif
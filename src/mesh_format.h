@@ -0,0 +1,74 @@
+#ifndef CG_MESH_FORMAT
+#define CG_MESH_FORMAT
+
+#include <cstdint>
+
+/*
+ *   ,   GPU (.cgmesh).
+ *          OBJ  .glb 
+ * ( mesh_cache.h)        -   
+ *        ,    .
+ *
+ * :
+ *   MeshFileHeader
+ *   MeshFileSubmesh[submesh_count]
+ *   MeshFileLod[lod_count]         -     - 
+ *    (MeshVertex, 32 ),   mesh_file_alignment 
+ *    (uint32_t,  ),   mesh_file_alignment 
+ */
+namespace cg
+{
+
+constexpr char mesh_file_magic[4] = { 'C', 'G', 'M', 'S' };
+constexpr uint32_t mesh_file_version = 1;
+constexpr uint32_t mesh_file_alignment = 64;
+
+struct MeshFileHeader
+{
+    char magic[4];          // "CGMS"
+    uint32_t version;       // mesh_file_version
+    uint64_t source_hash;   //     ,    
+    uint64_t source_size;   //    
+    uint32_t vertex_size;   // sizeof(MeshVertex) -    
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t submesh_count;
+    uint32_t lod_count;
+    uint32_t reserved0;
+    uint64_t vertex_offset; //       
+    uint64_t index_offset;  //       
+    float bounds_min[3];    //    
+    float bounds_max[3];
+    uint32_t reserved[2];
+};
+
+/*
+ *     (  OBJ, mesh  glTF)   .
+ *      -       .
+ */
+struct MeshFileSubmesh
+{
+    uint32_t first_index;
+    uint32_t index_count;
+    float bounds_min[3];
+    float bounds_max[3];
+};
+
+/*
+ *    -          .
+ */
+struct MeshFileLod
+{
+    uint32_t first_index;
+    uint32_t index_count;
+    float error;            //         
+    uint32_t reserved;
+};
+
+static_assert(sizeof(MeshFileHeader) == 96, "Unexpected header size");
+static_assert(sizeof(MeshFileSubmesh) == 32, "Unexpected submesh size");
+static_assert(sizeof(MeshFileLod) == 16, "Unexpected LOD size");
+
+} // namespace cg
+
+#endif
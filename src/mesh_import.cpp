@@ -0,0 +1,1277 @@
+#include "mesh_import.h"
+#include "archive.h"
+#include "mesh_optimizer.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+/*
+ *     Wavefront OBJ   glTF 2.0 (.glb).
+ *      ( open_resource())     .
+ * OBJ      ,        .
+ */
+namespace cg
+{
+    constexpr size_t obj_min_chunk_size = 256 * 1024;      // -       
+    constexpr int json_max_depth = 64;
+    constexpr int gltf_max_node_depth = 64;
+    constexpr size_t max_mesh_lods = 4;             // -    ( )
+    constexpr float lod_grid_resolution = 128.0f;   //         
+    constexpr float lod_min_grid_resolution = 4.0f; // - 
+    constexpr float lod_min_reduction = 0.6f;       //          
+
+    /*
+     *   8          
+     * (SWAR - SIMD  64- ,   simdjson  fast_float).
+     *    little-endian -     - .
+     */
+    static inline bool is_eight_digits(uint64_t word)
+    {
+        return (((word & 0xF0F0F0F0F0F0F0F0ull) |
+            (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+    }
+
+    static inline uint32_t parse_eight_digits(uint64_t word)
+    {
+        const uint64_t mask = 0x000000FF000000FFull;
+        const uint64_t multiplier_high = 0x000F424000000064ull;    // 100 + (1000000 << 32)
+        const uint64_t multiplier_low = 0x0000271000000001ull;     // 1 + (10000 << 32)
+        word -= 0x3030303030303030ull;
+        word = (word * 10) + (word >> 8);   //  
+        word = (((word & mask) * multiplier_high) + (((word >> 16) & mask) * multiplier_low)) >> 32;
+        return static_cast<uint32_t>(word);
+    }
+
+    static inline bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /*
+     *   p ,   mantissa.   .
+     */
+    static inline const char* parse_digits(const char* p, const char* end, uint64_t& mantissa)
+    {
+        while (end - p >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            if (is_eight_digits(word) == false)
+                break;
+            mantissa = mantissa * 100000000 + parse_eight_digits(word);
+            p += 8;
+        }
+        while (p < end && is_digit(*p))
+        {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            p++;
+        }
+        return p;
+    }
+
+    /*
+     *   float.      nullptr  .
+     *      24 ,    10   10,    
+     * float          
+     * (   Clinger).       OBJ .
+     *     std::from_chars,    .
+     */
+    static const char* parse_float(const char* p, const char* end, float& value)
+    {
+        static constexpr float powers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+        if (p < end && *p == '+')
+            p++;
+        const char* start = p;
+        const bool negative = p < end && *p == '-';
+        if (negative)
+            p++;
+
+        uint64_t mantissa = 0;
+        const char* digits = p;
+        p = parse_digits(p, end, mantissa);
+        size_t digit_count = static_cast<size_t>(p - digits);
+
+        int exponent = 0;
+        if (p < end && *p == '.')
+        {
+            const char* fraction = ++p;
+            p = parse_digits(p, end, mantissa);
+            exponent = -static_cast<int>(p - fraction);
+            digit_count += static_cast<size_t>(p - fraction);
+        }
+        if (digit_count == 0)
+            return nullptr;
+
+        if (p < end && (*p == 'e' || *p == 'E'))
+        {
+            const char* q = p + 1;
+            const bool negative_exponent = q < end && *q == '-';
+            if (q < end && (*q == '-' || *q == '+'))
+                q++;
+
+            int power = 0;
+            const char* power_digits = q;
+            while (q < end && is_digit(*q) && power < 10000)
+                power = power * 10 + (*q++ - '0');
+            if (q == power_digits)
+                return nullptr;
+
+            exponent += negative_exponent ? -power : power;
+            p = q;
+        }
+
+        if (digit_count <= 19 && mantissa <= (1u << 24) && exponent >= -10 && exponent <= 10)
+        {
+            const float result = static_cast<float>(mantissa);
+            value = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+            if (negative)
+                value = -value;
+            return p;
+        }
+
+        const std::from_chars_result result = std::from_chars(start, end, value);
+        if (result.ec != std::errc())
+            return nullptr;
+        return result.ptr;
+    }
+
+    static inline const char* parse_int(const char* p, const char* end, int64_t& value)
+    {
+        const bool negative = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+'))
+            p++;
+
+        uint64_t magnitude = 0;
+        const char* digits = p;
+        while (p < end && is_digit(*p) && magnitude < (1ull << 40))
+            magnitude = magnitude * 10 + static_cast<uint64_t>(*p++ - '0');
+        if (p == digits)
+            return nullptr;
+
+        value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+        return p;
+    }
+
+    static inline const char* skip_spaces(const char* p, const char* end)
+    {
+        while (p < end && (*p == ' ' || *p == '\t'))
+            p++;
+        return p;
+    }
+
+    static inline const char* next_line(const char* p, const char* end)
+    {
+        const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        return newline != nullptr ? static_cast<const char*>(newline) + 1 : end;
+    }
+
+    /*
+     *     OBJ:   ,    .
+     *     ( 0).   OBJ  
+     *      -         
+     *           ( ObjChunk::relative).
+     */
+    constexpr int32_t obj_missing = std::numeric_limits<int32_t>::min();
+
+    struct ObjCorner
+    {
+        int32_t position;
+        int32_t tex_coord;
+        int32_t normal;
+    };
+
+    /*
+     *        OBJ .
+     */
+    struct ObjChunk
+    {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> tex_coords;
+        std::vector<glm::vec3> normals;
+        std::vector<ObjCorner> corners;         //    
+        std::vector<uint32_t> relative;         //    * 3 + ,   
+        std::vector<uint32_t> groups;           // ,      (o  g)
+        bool failed = false;
+    };
+
+    /*
+     *       count    ( ).
+     */
+    static bool resolve_obj_index(int64_t index, size_t count, int32_t& result, bool& relative)
+    {
+        if (index > 0 && index <= std::numeric_limits<int32_t>::max())
+        {
+            result = static_cast<int32_t>(index - 1);
+            return true;
+        }
+        if (index < 0 && -index <= std::numeric_limits<int32_t>::max())
+        {
+            result = static_cast<int32_t>(static_cast<int64_t>(count) + index);
+            relative = true;
+            return true;
+        }
+        return false;
+    }
+
+    /*
+     *   : v, v/vt, v//vn  v/vt/vn.
+     */
+    static const char* parse_obj_corner(const char* p, const char* end, ObjChunk& chunk,
+        ObjCorner& corner, unsigned int& relative_mask)
+    {
+        int64_t index = 0;
+        bool relative = false;
+        corner = { obj_missing, obj_missing, obj_missing };
+        relative_mask = 0;
+
+        p = parse_int(p, end, index);
+        if (p == nullptr || resolve_obj_index(index, chunk.positions.size(), corner.position, relative) == false)
+            return nullptr;
+        relative_mask |= relative ? 1u : 0u;
+
+        if (p < end && *p == '/')
+        {
+            p++;
+            if (p < end && *p != '/')
+            {
+                relative = false;
+                p = parse_int(p, end, index);
+                if (p == nullptr || resolve_obj_index(index, chunk.tex_coords.size(), corner.tex_coord, relative) == false)
+                    return nullptr;
+                relative_mask |= relative ? 2u : 0u;
+            }
+            if (p < end && *p == '/')
+            {
+                relative = false;
+                p = parse_int(p + 1, end, index);
+                if (p == nullptr || resolve_obj_index(index, chunk.normals.size(), corner.normal, relative) == false)
+                    return nullptr;
+                relative_mask |= relative ? 4u : 0u;
+            }
+        }
+        return p;
+    }
+
+    static void push_obj_corner(ObjChunk& chunk, const ObjCorner& corner, unsigned int relative_mask)
+    {
+        const uint32_t index = static_cast<uint32_t>(chunk.corners.size());
+        chunk.corners.push_back(corner);
+        for (uint32_t attribute = 0; attribute < 3; attribute++)
+        {
+            if (relative_mask & (1u << attribute))
+                chunk.relative.push_back(index * 3 + attribute);
+        }
+    }
+
+    /*
+     *     ,     .
+     */
+    static const char* parse_obj_face(const char* p, const char* end, ObjChunk& chunk)
+    {
+        ObjCorner first = {}, previous = {};
+        unsigned int first_mask = 0, previous_mask = 0;
+        int count = 0;
+
+        while (true)
+        {
+            p = skip_spaces(p, end);
+            if (p == end || *p == '\n' || *p == '\r' || *p == '#')
+                break;
+
+            ObjCorner corner;
+            unsigned int mask;
+            p = parse_obj_corner(p, end, chunk, corner, mask);
+            if (p == nullptr)
+                return nullptr;
+
+            if (count == 0)
+            {
+                first = corner;
+                first_mask = mask;
+            }
+            else if (count >= 2)
+            {
+                push_obj_corner(chunk, first, first_mask);
+                push_obj_corner(chunk, previous, previous_mask);
+                push_obj_corner(chunk, corner, mask);
+            }
+            previous = corner;
+            previous_mask = mask;
+            count++;
+        }
+        return p;
+    }
+
+    template <int N>
+    static const char* parse_obj_floats(const char* p, const char* end, float* values)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            p = skip_spaces(p, end);
+            p = parse_float(p, end, values[i]);
+            if (p == nullptr)
+                return nullptr;
+        }
+        return p;
+    }
+
+    /*
+     *     OBJ  (       ).
+     *    (o, g)     .
+     *       -    .
+     */
+    static void parse_obj_chunk(const char* p, const char* end, ObjChunk& chunk)
+    {
+        while (p < end)
+        {
+            p = skip_spaces(p, end);
+            if (p + 1 < end && p[0] == 'v')
+            {
+                const char type = p[1];
+                if (type == ' ' || type == '\t')
+                {
+                    glm::vec3 position;
+                    p = parse_obj_floats<3>(p + 1, end, glm::value_ptr(position));
+                    chunk.positions.push_back(position);
+                }
+                else if (type == 't')
+                {
+                    glm::vec2 tex_coord;
+                    p = parse_obj_floats<2>(p + 2, end, glm::value_ptr(tex_coord));
+                    chunk.tex_coords.push_back(tex_coord);
+                }
+                else if (type == 'n')
+                {
+                    glm::vec3 normal;
+                    p = parse_obj_floats<3>(p + 2, end, glm::value_ptr(normal));
+                    chunk.normals.push_back(normal);
+                }
+            }
+            else if (p + 1 < end && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+            {
+                p = parse_obj_face(p + 1, end, chunk);
+            }
+            else if (p + 1 < end && (p[0] == 'o' || p[0] == 'g') && (p[1] == ' ' || p[1] == '\t'))
+            {
+                chunk.groups.push_back(static_cast<uint32_t>(chunk.corners.size()));
+            }
+
+            if (p == nullptr)
+            {
+                chunk.failed = true;
+                return;
+            }
+            p = next_line(p, end);
+        }
+    }
+
+    /*
+     *     (,  , ) -> .
+     */
+    static inline uint32_t hash_corner(const ObjCorner& corner)
+    {
+        uint32_t hash = static_cast<uint32_t>(corner.position) * 73856093u;
+        hash ^= static_cast<uint32_t>(corner.tex_coord) * 19349663u;
+        hash ^= static_cast<uint32_t>(corner.normal) * 83492791u;
+        return hash ^ (hash >> 15);
+    }
+
+    /*
+     * OBJ .    ,      
+     *          .
+     */
+    bool parse_obj(std::span<const unsigned char> data, ImportedMesh& mesh)
+    {
+        const char* text = reinterpret_cast<const char*>(data.data());
+        const size_t size = data.size();
+
+        const size_t threads = get_thread_count() + 1;
+        const size_t chunk_count = std::clamp<size_t>(size / obj_min_chunk_size, 1, threads);
+
+        //        
+        std::vector<size_t> bounds(chunk_count + 1, size);
+        bounds[0] = 0;
+        for (size_t i = 1; i < chunk_count; i++)
+        {
+            const char* start = text + std::max(size * i / chunk_count, bounds[i - 1]);
+            bounds[i] = static_cast<size_t>(next_line(start, text + size) - text);
+        }
+
+        std::vector<ObjChunk> chunks(chunk_count);
+        parallel_for(static_cast<int>(chunk_count), [&](int i)
+            {
+                parse_obj_chunk(text + bounds[i], text + bounds[i + 1], chunks[i]);
+            });
+
+        //      
+        struct Offsets
+        {
+            size_t positions, tex_coords, normals, corners;
+        };
+        std::vector<Offsets> offsets(chunk_count + 1, Offsets{ 0, 0, 0, 0 });
+        for (size_t i = 0; i < chunk_count; i++)
+        {
+            if (chunks[i].failed)
+            {
+                std::cerr << "Invalid OBJ data." << std::endl;
+                return false;
+            }
+            offsets[i + 1].positions = offsets[i].positions + chunks[i].positions.size();
+            offsets[i + 1].tex_coords = offsets[i].tex_coords + chunks[i].tex_coords.size();
+            offsets[i + 1].normals = offsets[i].normals + chunks[i].normals.size();
+            offsets[i + 1].corners = offsets[i].corners + chunks[i].corners.size();
+        }
+
+        const Offsets& total = offsets[chunk_count];
+        if (total.positions > static_cast<size_t>(std::numeric_limits<int32_t>::max()) ||
+            total.corners > std::numeric_limits<uint32_t>::max() / 2)
+        {
+            std::cerr << "OBJ mesh is too large." << std::endl;
+            return false;
+        }
+
+        /*
+         *       (  ).
+         */
+        std::vector<char> valid(chunk_count, 1);
+        parallel_for(static_cast<int>(chunk_count), [&](int i)
+            {
+                ObjChunk& chunk = chunks[i];
+                for (uint32_t entry : chunk.relative)
+                {
+                    ObjCorner& corner = chunk.corners[entry / 3];
+                    switch (entry % 3)
+                    {
+                    case 0: corner.position += static_cast<int32_t>(offsets[i].positions); break;
+                    case 1: corner.tex_coord += static_cast<int32_t>(offsets[i].tex_coords); break;
+                    default: corner.normal += static_cast<int32_t>(offsets[i].normals); break;
+                    }
+                }
+
+                for (const ObjCorner& corner : chunk.corners)
+                {
+                    if (corner.position < 0 || static_cast<size_t>(corner.position) >= total.positions ||
+                        (corner.tex_coord != obj_missing &&
+                            (corner.tex_coord < 0 || static_cast<size_t>(corner.tex_coord) >= total.tex_coords)) ||
+                        (corner.normal != obj_missing &&
+                            (corner.normal < 0 || static_cast<size_t>(corner.normal) >= total.normals)))
+                    {
+                        valid[i] = 0;
+                        return;
+                    }
+                }
+            });
+        if (std::find(valid.begin(), valid.end(), 0) != valid.end())
+        {
+            std::cerr << "OBJ face index out of range." << std::endl;
+            return false;
+        }
+
+        //       
+        std::vector<glm::vec3> positions(total.positions);
+        std::vector<glm::vec2> tex_coords(total.tex_coords);
+        std::vector<glm::vec3> normals(total.normals);
+        parallel_for(static_cast<int>(chunk_count), [&](int i)
+            {
+                std::copy(chunks[i].positions.begin(), chunks[i].positions.end(), positions.begin() + offsets[i].positions);
+                std::copy(chunks[i].tex_coords.begin(), chunks[i].tex_coords.end(), tex_coords.begin() + offsets[i].tex_coords);
+                std::copy(chunks[i].normals.begin(), chunks[i].normals.end(), normals.begin() + offsets[i].normals);
+            });
+
+        /*
+         *      .     
+         * -     (     ).
+         */
+        size_t capacity = 16;
+        while (capacity < total.corners * 2)
+            capacity *= 2;
+        const size_t mask = capacity - 1;
+        std::vector<uint32_t> table(capacity, 0xFFFFFFFFu);
+        std::vector<ObjCorner> keys;
+
+        mesh.vertices.clear();
+        mesh.indices.clear();
+        mesh.submeshes.clear();
+        mesh.indices.reserve(total.corners);
+        for (const ObjChunk& chunk : chunks)
+        {
+            for (const ObjCorner& corner : chunk.corners)
+            {
+                size_t slot = hash_corner(corner) & mask;
+                while (true)
+                {
+                    const uint32_t entry = table[slot];
+                    if (entry == 0xFFFFFFFFu)
+                    {
+                        MeshVertex vertex;
+                        vertex.position = positions[corner.position];
+                        vertex.tex_coord = corner.tex_coord != obj_missing ? tex_coords[corner.tex_coord] : glm::vec2(0.0f);
+                        vertex.normal = corner.normal != obj_missing ? normals[corner.normal] : glm::vec3(0.0f);
+
+                        table[slot] = static_cast<uint32_t>(mesh.vertices.size());
+                        mesh.indices.push_back(table[slot]);
+                        mesh.vertices.push_back(vertex);
+                        keys.push_back(corner);
+                        break;
+                    }
+
+                    const ObjCorner& key = keys[entry];
+                    if (key.position == corner.position && key.tex_coord == corner.tex_coord && key.normal == corner.normal)
+                    {
+                        mesh.indices.push_back(entry);
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+            }
+        }
+
+        //    -    ,  
+        uint32_t first_index = 0;
+        auto end_submesh = [&](size_t end)
+            {
+                if (end > first_index)
+                    mesh.submeshes.push_back({ first_index, static_cast<uint32_t>(end) - first_index });
+                first_index = static_cast<uint32_t>(end);
+            };
+        for (size_t i = 0; i < chunk_count; i++)
+        {
+            for (uint32_t start : chunks[i].groups)
+                end_submesh(offsets[i].corners + start);
+        }
+        end_submesh(total.corners);
+
+        return true;
+    }
+
+    /*
+     *  JSON  -   glTF .
+     */
+    struct JsonValue
+    {
+        enum Type { JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING, JSON_ARRAY, JSON_OBJECT };
+
+        Type type = JSON_NULL;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> items;                               // JSON_ARRAY
+        std::vector<std::pair<std::string, JsonValue>> members;     // JSON_OBJECT
+    };
+
+    struct JsonParser
+    {
+        const char* p;
+        const char* end;
+    };
+
+    static void skip_json_spaces(JsonParser& parser)
+    {
+        while (parser.p < parser.end &&
+            (*parser.p == ' ' || *parser.p == '\t' || *parser.p == '\n' || *parser.p == '\r'))
+            parser.p++;
+    }
+
+    /*
+     *   . \uXXXX  ASCII    '?' -   glTF  ASCII.
+     */
+    static bool parse_json_string(JsonParser& parser, std::string& result)
+    {
+        if (parser.p >= parser.end || *parser.p != '"')
+            return false;
+        parser.p++;
+
+        result.clear();
+        while (parser.p < parser.end && *parser.p != '"')
+        {
+            char c = *parser.p++;
+            if (c == '\\')
+            {
+                if (parser.p >= parser.end)
+                    return false;
+                c = *parser.p++;
+                switch (c)
+                {
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                case 'u':
+                {
+                    unsigned int code = 0;
+                    if (parser.end - parser.p < 4 ||
+                        std::from_chars(parser.p, parser.p + 4, code, 16).ptr != parser.p + 4)
+                        return false;
+                    parser.p += 4;
+                    c = code < 0x80 ? static_cast<char>(code) : '?';
+                    break;
+                }
+                default: break;     // \" \\ \/
+                }
+            }
+            result.push_back(c);
+        }
+
+        if (parser.p >= parser.end)
+            return false;
+        parser.p++;
+        return true;
+    }
+
+    static bool parse_json_value(JsonParser& parser, JsonValue& value, int depth)
+    {
+        skip_json_spaces(parser);
+        if (parser.p >= parser.end || depth > json_max_depth)
+            return false;
+
+        auto literal = [&parser](std::string_view word)
+            {
+                if (static_cast<size_t>(parser.end - parser.p) < word.size() ||
+                    std::string_view(parser.p, word.size()) != word)
+                    return false;
+                parser.p += word.size();
+                return true;
+            };
+
+        const char c = *parser.p;
+        if (c == '{')
+        {
+            value.type = JsonValue::JSON_OBJECT;
+            parser.p++;
+            skip_json_spaces(parser);
+            if (parser.p < parser.end && *parser.p == '}')
+            {
+                parser.p++;
+                return true;
+            }
+
+            while (true)
+            {
+                std::pair<std::string, JsonValue> member;
+                skip_json_spaces(parser);
+                if (parse_json_string(parser, member.first) == false)
+                    return false;
+                skip_json_spaces(parser);
+                if (parser.p >= parser.end || *parser.p++ != ':')
+                    return false;
+                if (parse_json_value(parser, member.second, depth + 1) == false)
+                    return false;
+                value.members.push_back(std::move(member));
+
+                skip_json_spaces(parser);
+                if (parser.p >= parser.end)
+                    return false;
+                if (*parser.p == '}')
+                {
+                    parser.p++;
+                    return true;
+                }
+                if (*parser.p++ != ',')
+                    return false;
+            }
+        }
+        if (c == '[')
+        {
+            value.type = JsonValue::JSON_ARRAY;
+            parser.p++;
+            skip_json_spaces(parser);
+            if (parser.p < parser.end && *parser.p == ']')
+            {
+                parser.p++;
+                return true;
+            }
+
+            while (true)
+            {
+                value.items.emplace_back();
+                if (parse_json_value(parser, value.items.back(), depth + 1) == false)
+                    return false;
+
+                skip_json_spaces(parser);
+                if (parser.p >= parser.end)
+                    return false;
+                if (*parser.p == ']')
+                {
+                    parser.p++;
+                    return true;
+                }
+                if (*parser.p++ != ',')
+                    return false;
+            }
+        }
+        if (c == '"')
+        {
+            value.type = JsonValue::JSON_STRING;
+            return parse_json_string(parser, value.string);
+        }
+        if (literal("true"))
+        {
+            value.type = JsonValue::JSON_BOOL;
+            value.number = 1.0;
+            return true;
+        }
+        if (literal("false"))
+        {
+            value.type = JsonValue::JSON_BOOL;
+            return true;
+        }
+        if (literal("null"))
+        {
+            value.type = JsonValue::JSON_NULL;
+            return true;
+        }
+
+        value.type = JsonValue::JSON_NUMBER;
+        const std::from_chars_result result = std::from_chars(parser.p, parser.end, value.number);
+        if (result.ec != std::errc())
+            return false;
+        parser.p = result.ptr;
+        return true;
+    }
+
+    static const JsonValue* json_member(const JsonValue* object, std::string_view name)
+    {
+        if (object == nullptr || object->type != JsonValue::JSON_OBJECT)
+            return nullptr;
+        for (const auto& member : object->members)
+        {
+            if (member.first == name)
+                return &member.second;
+        }
+        return nullptr;
+    }
+
+    /*
+     *       JSON  (    ).
+     */
+    static const JsonValue* json_item(const JsonValue* array, double index)
+    {
+        if (array == nullptr || array->type != JsonValue::JSON_ARRAY ||
+            (index >= 0.0 && index < static_cast<double>(array->items.size())) == false ||
+            index != std::floor(index))
+            return nullptr;
+        return &array->items[static_cast<size_t>(index)];
+    }
+
+    static double json_number(const JsonValue* object, std::string_view name, double fallback)
+    {
+        const JsonValue* value = json_member(object, name);
+        return value != nullptr && value->type == JsonValue::JSON_NUMBER ? value->number : fallback;
+    }
+
+    /*
+     *   json_item()  JSON . ,    ,   .
+     */
+    static double json_index(const JsonValue* value)
+    {
+        return value != nullptr && value->type == JsonValue::JSON_NUMBER ? value->number : -1.0;
+    }
+
+    /*
+     *    -   JSON   2^53 (   - fallback).
+     *  false   ,      size_t.
+     */
+    static bool json_size(const JsonValue* object, std::string_view name, size_t fallback, size_t& result)
+    {
+        const JsonValue* value = json_member(object, name);
+        if (value == nullptr)
+        {
+            result = fallback;
+            return true;
+        }
+
+        if (value->type != JsonValue::JSON_NUMBER || (value->number >= 0.0 && value->number <= 9007199254740992.0) == false ||
+            value->number != std::floor(value->number))
+            return false;
+        result = static_cast<size_t>(value->number);
+        return true;
+    }
+
+    /*
+     *   glTF     .
+     */
+    struct GltfFile
+    {
+        JsonValue json;
+        std::span<const unsigned char> binary;
+    };
+
+    /*
+     *   accessor: ,     .
+     */
+    struct GltfAccessor
+    {
+        const unsigned char* data;
+        size_t count;
+        size_t stride;
+        int component_type;
+        int components;
+        bool normalized;
+    };
+
+    static size_t component_size(int component_type)
+    {
+        switch (component_type)
+        {
+        case 5120: case 5121: return 1;     // BYTE, UNSIGNED_BYTE
+        case 5122: case 5123: return 2;     // SHORT, UNSIGNED_SHORT
+        case 5125: case 5126: return 4;     // UNSIGNED_INT, FLOAT
+        default: return 0;
+        }
+    }
+
+    static int type_components(const std::string& type)
+    {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2") return 2;
+        if (type == "VEC3") return 3;
+        if (type == "VEC4") return 4;
+        return 0;
+    }
+
+    /*
+     *   accessor  ,        .
+     */
+    static bool get_accessor(const GltfFile& file, double index, GltfAccessor& accessor)
+    {
+        const JsonValue* object = json_item(json_member(&file.json, "accessors"), index);
+        const JsonValue* type = json_member(object, "type");
+        if (object == nullptr || type == nullptr || json_member(object, "sparse") != nullptr)
+            return false;
+
+        const JsonValue* view = json_item(json_member(&file.json, "bufferViews"),
+            json_number(object, "bufferView", -1.0));
+        if (view == nullptr || json_number(view, "buffer", 0.0) != 0.0)
+            return false;   //      .glb
+
+        size_t component_type = 0;
+        if (json_size(object, "count", 0, accessor.count) == false ||
+            json_size(object, "componentType", 0, component_type) == false)
+            return false;
+        accessor.component_type = component_type <= 0xFFFF ? static_cast<int>(component_type) : 0;
+        accessor.components = type_components(type->string);
+        const JsonValue* normalized = json_member(object, "normalized");
+        accessor.normalized = normalized != nullptr && normalized->number != 0.0;
+
+        const size_t element_size = component_size(accessor.component_type) * accessor.components;
+        size_t view_offset, view_length, offset;
+        if (json_size(view, "byteOffset", 0, view_offset) == false ||
+            json_size(view, "byteLength", 0, view_length) == false ||
+            json_size(object, "byteOffset", 0, offset) == false ||
+            json_size(view, "byteStride", element_size, accessor.stride) == false)
+            return false;
+        if (element_size == 0 || accessor.stride < element_size || offset > view_length ||
+            view_offset > file.binary.size() || view_length > file.binary.size() - view_offset)
+            return false;
+
+        const size_t available = view_length - offset;
+        if (accessor.count > 0 &&
+            (element_size > available || accessor.count - 1 > (available - element_size) / accessor.stride))
+            return false;
+
+        accessor.data = file.binary.data() + view_offset + offset;
+        return true;
+    }
+
+    /*
+     *     float (    ,   ).
+     */
+    static float read_component(const GltfAccessor& accessor, size_t element, int component)
+    {
+        const unsigned char* p = accessor.data + element * accessor.stride + component * component_size(accessor.component_type);
+        switch (accessor.component_type)
+        {
+        case 5120: { int8_t v; std::memcpy(&v, p, 1); return accessor.normalized ? std::max(v / 127.0f, -1.0f) : v; }
+        case 5121: { uint8_t v; std::memcpy(&v, p, 1); return accessor.normalized ? v / 255.0f : v; }
+        case 5122: { int16_t v; std::memcpy(&v, p, 2); return accessor.normalized ? std::max(v / 32767.0f, -1.0f) : v; }
+        case 5123: { uint16_t v; std::memcpy(&v, p, 2); return accessor.normalized ? v / 65535.0f : v; }
+        case 5125: { uint32_t v; std::memcpy(&v, p, 4); return static_cast<float>(v); }
+        default: { float v; std::memcpy(&v, p, 4); return v; }
+        }
+    }
+
+    static uint32_t read_index(const GltfAccessor& accessor, size_t element)
+    {
+        const unsigned char* p = accessor.data + element * accessor.stride;
+        switch (accessor.component_type)
+        {
+        case 5121: return *p;
+        case 5123: { uint16_t v; std::memcpy(&v, p, 2); return v; }
+        default: { uint32_t v; std::memcpy(&v, p, 4); return v; }
+        }
+    }
+
+    /*
+     *    ()     .
+     *    glTF     ,   
+     *      - v  .
+     */
+    static bool append_gltf_primitive(const GltfFile& file, const JsonValue& primitive,
+        const glm::mat4& transform, ImportedMesh& mesh)
+    {
+        if (json_number(&primitive, "mode", 4.0) != 4.0)
+            return true;    //   -     
+
+        const JsonValue* attributes = json_member(&primitive, "attributes");
+        const JsonValue* position_index = json_member(attributes, "POSITION");
+        const JsonValue* normal_index = json_member(attributes, "NORMAL");
+        const JsonValue* tex_coord_index = json_member(attributes, "TEXCOORD_0");
+
+        GltfAccessor positions, normals, tex_coords;
+        if (position_index == nullptr || get_accessor(file, json_index(position_index), positions) == false ||
+            positions.components != 3)
+            return false;
+
+        const bool has_normals = normal_index != nullptr;
+        const bool has_tex_coords = tex_coord_index != nullptr;
+        if ((has_normals && (get_accessor(file, json_index(normal_index), normals) == false ||
+                normals.components != 3 || normals.count != positions.count)) ||
+            (has_tex_coords && (get_accessor(file, json_index(tex_coord_index), tex_coords) == false ||
+                tex_coords.components != 2 || tex_coords.count != positions.count)))
+            return false;
+
+        const glm::mat3 normal_matrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+        const uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+        for (size_t i = 0; i < positions.count; i++)
+        {
+            MeshVertex vertex;
+            const glm::vec3 position(read_component(positions, i, 0), read_component(positions, i, 1),
+                read_component(positions, i, 2));
+            vertex.position = glm::vec3(transform * glm::vec4(position, 1.0f));
+            vertex.normal = glm::vec3(0.0f);
+            if (has_normals)
+            {
+                const glm::vec3 normal = normal_matrix * glm::vec3(read_component(normals, i, 0),
+                    read_component(normals, i, 1), read_component(normals, i, 2));
+                const float length = glm::length(normal);
+                vertex.normal = length > 0.0f ? normal / length : normal;
+            }
+            vertex.tex_coord = has_tex_coords ?
+                glm::vec2(read_component(tex_coords, i, 0), 1.0f - read_component(tex_coords, i, 1)) : glm::vec2(0.0f);
+            mesh.vertices.push_back(vertex);
+        }
+
+        //        
+        const bool mirrored = glm::determinant(glm::mat3(transform)) < 0.0f;
+        const size_t first = mesh.indices.size();
+        const JsonValue* indices_index = json_member(&primitive, "indices");
+        if (indices_index != nullptr)
+        {
+            GltfAccessor indices;
+            if (get_accessor(file, json_index(indices_index), indices) == false || indices.components != 1 ||
+                indices.component_type == 5126 || indices.component_type == 5120 || indices.component_type == 5122)
+                return false;
+
+            for (size_t i = 0; i + 2 < indices.count; i += 3)
+            {
+                for (size_t corner = 0; corner < 3; corner++)
+                {
+                    const uint32_t index = read_index(indices, i + corner);
+                    if (index >= positions.count)
+                        return false;
+                    mesh.indices.push_back(base + index);
+                }
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i + 2 < positions.count; i += 3)
+            {
+                for (uint32_t corner = 0; corner < 3; corner++)
+                    mesh.indices.push_back(base + static_cast<uint32_t>(i) + corner);
+            }
+        }
+
+        if (mirrored)
+        {
+            for (size_t i = first; i + 2 < mesh.indices.size(); i += 3)
+                std::swap(mesh.indices[i + 1], mesh.indices[i + 2]);
+        }
+        return true;
+    }
+
+    static bool append_gltf_mesh(const GltfFile& file, double index, const glm::mat4& transform, ImportedMesh& mesh)
+    {
+        const JsonValue* object = json_item(json_member(&file.json, "meshes"), index);
+        const JsonValue* primitives = json_member(object, "primitives");
+        if (primitives == nullptr || primitives->type != JsonValue::JSON_ARRAY)
+            return false;
+
+        const uint32_t first_index = static_cast<uint32_t>(mesh.indices.size());
+        for (const JsonValue& primitive : primitives->items)
+        {
+            if (append_gltf_primitive(file, primitive, transform, mesh) == false)
+                return false;
+        }
+
+        //    mesh  ( )     
+        const uint32_t index_count = static_cast<uint32_t>(mesh.indices.size()) - first_index;
+        if (index_count > 0)
+            mesh.submeshes.push_back({ first_index, index_count });
+        return true;
+    }
+
+    /*
+     *    : matrix   *  * .
+     */
+    static glm::mat4 node_transform(const JsonValue& node)
+    {
+        auto vector = [&node](std::string_view name, float* values, size_t count)
+            {
+                const JsonValue* array = json_member(&node, name);
+                if (array == nullptr || array->type != JsonValue::JSON_ARRAY || array->items.size() != count)
+                    return false;
+                for (size_t i = 0; i < count; i++)
+                    values[i] = static_cast<float>(array->items[i].number);
+                return true;
+            };
+
+        glm::mat4 matrix(1.0f);
+        if (vector("matrix", glm::value_ptr(matrix), 16))
+            return matrix;      //  ,   GLM
+
+        glm::vec3 translation(0.0f), scale(1.0f);
+        glm::vec4 rotation(0.0f, 0.0f, 0.0f, 1.0f);     // x, y, z, w
+        vector("translation", glm::value_ptr(translation), 3);
+        vector("rotation", glm::value_ptr(rotation), 4);
+        vector("scale", glm::value_ptr(scale), 3);
+
+        const glm::quat orientation(rotation.w, rotation.x, rotation.y, rotation.z);
+        return glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(orientation) *
+            glm::scale(glm::mat4(1.0f), scale);
+    }
+
+    /*
+     *    .   glTF   -    
+     * -   .   (   )   ,
+     *           .
+     */
+    static bool append_gltf_node(const GltfFile& file, double index, const glm::mat4& parent,
+        ImportedMesh& mesh, std::vector<bool>& visited, int depth)
+    {
+        const JsonValue* node = json_item(json_member(&file.json, "nodes"), index);
+        if (node == nullptr || depth > gltf_max_node_depth || visited[static_cast<size_t>(index)])
+            return false;
+        visited[static_cast<size_t>(index)] = true;
+
+        const glm::mat4 transform = parent * node_transform(*node);
+        const JsonValue* mesh_index = json_member(node, "mesh");
+        if (mesh_index != nullptr && append_gltf_mesh(file, json_index(mesh_index), transform, mesh) == false)
+            return false;
+
+        const JsonValue* children = json_member(node, "children");
+        if (children != nullptr && children->type == JsonValue::JSON_ARRAY)
+        {
+            for (const JsonValue& child : children->items)
+            {
+                if (append_gltf_node(file, json_index(&child), transform, mesh, visited, depth + 1) == false)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    static uint32_t read_u32(const unsigned char* p)
+    {
+        uint32_t value;
+        std::memcpy(&value, p, 4);     // Little-endian
+        return value;
+    }
+
+    /*
+     *  glTF 2.0: , JSON     ( 0).
+     *           
+     *     .      mesh .
+     */
+    bool parse_glb(std::span<const unsigned char> data, ImportedMesh& mesh)
+    {
+        constexpr uint32_t glb_magic = 0x46546C67;     // "glTF"
+        constexpr uint32_t chunk_json = 0x4E4F534A;    // "JSON"
+        constexpr uint32_t chunk_binary = 0x004E4942;  // "BIN\0"
+
+        if (data.size() < 20 || read_u32(data.data()) != glb_magic || read_u32(data.data() + 4) != 2)
+        {
+            std::cerr << "Invalid glTF binary header." << std::endl;
+            return false;
+        }
+
+        const size_t length = std::min<size_t>(read_u32(data.data() + 8), data.size());
+        GltfFile file;
+        bool has_json = false;
+        for (size_t offset = 12; offset + 8 <= length;)
+        {
+            const size_t chunk_length = read_u32(data.data() + offset);
+            const uint32_t chunk_type = read_u32(data.data() + offset + 4);
+            const unsigned char* chunk = data.data() + offset + 8;
+            if (chunk_length > length - offset - 8)
+                break;
+
+            if (chunk_type == chunk_json && has_json == false)
+            {
+                JsonParser parser = { reinterpret_cast<const char*>(chunk), reinterpret_cast<const char*>(chunk) + chunk_length };
+                has_json = parse_json_value(parser, file.json, 0);
+                if (has_json == false)
+                {
+                    std::cerr << "Invalid glTF JSON." << std::endl;
+                    return false;
+                }
+            }
+            else if (chunk_type == chunk_binary && file.binary.empty())
+            {
+                file.binary = std::span<const unsigned char>(chunk, chunk_length);
+            }
+            offset += 8 + ((chunk_length + 3) & ~size_t(3));
+        }
+        if (has_json == false)
+        {
+            std::cerr << "glTF file has no JSON chunk." << std::endl;
+            return false;
+        }
+
+        mesh.vertices.clear();
+        mesh.indices.clear();
+        mesh.submeshes.clear();
+
+        bool result = true;
+        const JsonValue* scene = json_item(json_member(&file.json, "scenes"), json_number(&file.json, "scene", 0.0));
+        const JsonValue* nodes = json_member(scene, "nodes");
+        const JsonValue* meshes = json_member(&file.json, "meshes");
+        if (nodes != nullptr && nodes->type == JsonValue::JSON_ARRAY)
+        {
+            const JsonValue* all_nodes = json_member(&file.json, "nodes");
+            std::vector<bool> visited(all_nodes != nullptr ? all_nodes->items.size() : 0, false);
+            for (const JsonValue& node : nodes->items)
+                result = result && append_gltf_node(file, json_index(&node), glm::mat4(1.0f), mesh, visited, 0);
+        }
+        else if (meshes != nullptr && meshes->type == JsonValue::JSON_ARRAY)
+        {
+            for (size_t i = 0; i < meshes->items.size(); i++)
+                result = result && append_gltf_mesh(file, static_cast<double>(i), glm::mat4(1.0f), mesh);
+        }
+        else
+        {
+            result = false;     //  ,    mesh 
+        }
+
+        if (result == false)
+            std::cerr << "Unsupported or invalid glTF mesh data." << std::endl;
+        return result;
+    }
+
+    /*
+     *   ,   indices.
+     */
+    static void compute_bounds(const std::vector<MeshVertex>& vertices, std::span<const uint32_t> indices,
+        glm::vec3& bounds_min, glm::vec3& bounds_max)
+    {
+        bounds_min = bounds_max = indices.empty() ? glm::vec3(0.0f) : vertices[indices[0]].position;
+        for (uint32_t index : indices)
+        {
+            bounds_min = glm::min(bounds_min, vertices[index].position);
+            bounds_max = glm::max(bounds_max, vertices[index].position);
+        }
+    }
+
+    /*
+     *       .    ,    -
+     *         .    
+     *  ( simplify_mesh())   - ,  lod_grid_resolution 
+     *     . ,     
+     *  ,  .
+     */
+    static void build_mesh_lods(ImportedMesh& mesh)
+    {
+        if (mesh.submeshes.empty())
+            mesh.submeshes.push_back({ 0, static_cast<uint32_t>(mesh.indices.size()) });
+
+        std::vector<uint32_t> output;
+        output.reserve(mesh.indices.size() * 3 / 2);
+        std::vector<uint32_t> clusters;
+        for (ImportedSubmesh& submesh : mesh.submeshes)
+        {
+            const size_t first = output.size();
+            output.insert(output.end(), mesh.indices.begin() + submesh.first_index,
+                mesh.indices.begin() + submesh.first_index + submesh.index_count);
+
+            const std::span<uint32_t> range(output.data() + first, submesh.index_count);
+            optimize_vertex_cache(range, mesh.vertices.size(), clusters);
+            optimize_overdraw(range, mesh.vertices, clusters);
+            compute_bounds(mesh.vertices, range, submesh.bounds_min, submesh.bounds_max);
+            submesh.first_index = static_cast<uint32_t>(first);
+        }
+        mesh.lods.assign(1, { 0, static_cast<uint32_t>(output.size()), 0.0f });
+
+        const float diagonal = glm::length(mesh.bounds_max - mesh.bounds_min);
+        std::vector<uint32_t> simplified;
+        for (float resolution = lod_grid_resolution; diagonal > 0.0f && resolution >= lod_min_grid_resolution &&
+            mesh.lods.size() < max_mesh_lods; resolution /= 2.0f)
+        {
+            const size_t first = output.size();
+            float error = 0.0f;
+            for (const ImportedSubmesh& submesh : mesh.submeshes)
+            {
+                const std::span<const uint32_t> range(output.data() + submesh.first_index, submesh.index_count);
+                error = std::max(error, simplify_mesh(mesh.vertices, range, submesh.bounds_min,
+                    diagonal / resolution, simplified));
+                output.insert(output.end(), simplified.begin(), simplified.end());
+            }
+
+            const size_t count = output.size() - first;
+            if (count == 0 || count > mesh.lods.back().index_count * lod_min_reduction)
+            {
+                output.resize(first);
+                continue;
+            }
+
+            optimize_vertex_cache(std::span<uint32_t>(output.data() + first, count), mesh.vertices.size(), clusters);
+            mesh.lods.push_back({ static_cast<uint32_t>(first), static_cast<uint32_t>(count), error / diagonal });
+        }
+
+        mesh.indices.swap(output);
+    }
+
+    /*
+     *     OBJ  .glb ( ,   )
+     *    :    ,  ,
+     *   ,        ,
+     *      (      ).
+     *       .   ,  false   -
+     *      .
+     */
+    bool import_mesh(const std::string& path, ImportedMesh& mesh)
+    {
+        mesh = ImportedMesh();
+
+        Resource resource;
+        if (open_resource(path, resource) == false)
+            return false;
+
+        const bool binary = resource.data.size() >= 4 && std::memcmp(resource.data.data(), "glTF", 4) == 0;
+        const bool parsed = binary ? parse_glb(resource.data, mesh) : parse_obj(resource.data, mesh);
+        close_resource(resource);
+        if (parsed == false || mesh.indices.empty())
+        {
+            std::cerr << "Failed to import mesh " << path << "." << std::endl;
+            mesh = ImportedMesh();
+            return false;
+        }
+
+        deduplicate_vertices(mesh.vertices, mesh.indices);
+        compute_missing_normals(mesh.vertices, mesh.indices);
+        compute_bounds(mesh.vertices, mesh.indices, mesh.bounds_min, mesh.bounds_max);
+        build_mesh_lods(mesh);
+        optimize_vertex_fetch(mesh.vertices, mesh.indices);
+        return true;
+    }
+
+} // namespace cg
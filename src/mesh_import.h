@@ -0,0 +1,48 @@
+#ifndef CG_MESH_IMPORT
+#define CG_MESH_IMPORT
+
+#include "mesh.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace cg
+{
+
+/*
+ *     (  OBJ, mesh  glTF):        .
+ */
+struct ImportedSubmesh
+{
+    uint32_t first_index;
+    uint32_t index_count;
+    glm::vec3 bounds_min = glm::vec3(0.0f);
+    glm::vec3 bounds_max = glm::vec3(0.0f);
+};
+
+/*
+ * ,       :
+ * ,         .
+ *        indices     .
+ */
+struct ImportedMesh
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;      // ,  vertices
+    std::vector<ImportedSubmesh> submeshes;
+    std::vector<MeshLod> lods;          //    
+    glm::vec3 bounds_min = glm::vec3(0.0f);
+    glm::vec3 bounds_max = glm::vec3(0.0f);
+};
+
+bool import_mesh(const std::string& path, ImportedMesh& mesh);
+bool parse_obj(std::span<const unsigned char> data, ImportedMesh& mesh);
+bool parse_glb(std::span<const unsigned char> data, ImportedMesh& mesh);
+
+} // namespace cg
+
+#endif
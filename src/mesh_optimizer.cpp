@@ -0,0 +1,396 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace cg
+{
+    constexpr uint32_t empty_slot = 0xFFFFFFFFu;
+    constexpr int vertex_cache_size = 16;      //     ,    
+
+    /*
+     *       (FNV-1a  32-    ).
+     *      -    memcmp.
+     */
+    static uint32_t hash_vertex(const MeshVertex& vertex)
+    {
+        uint32_t words[sizeof(MeshVertex) / 4];
+        std::memcpy(words, &vertex, sizeof(words));
+
+        uint32_t hash = 2166136261u;
+        for (uint32_t word : words)
+        {
+            hash ^= word;
+            hash *= 16777619u;
+        }
+        hash ^= hash >> 16;
+        hash *= 0x7feb352du;
+        hash ^= hash >> 15;
+        return hash;
+    }
+
+    /*
+     *        .
+     *     ,    -    .
+     *             .
+     */
+    void deduplicate_vertices(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        size_t capacity = 16;
+        while (capacity < vertices.size() * 2)
+            capacity *= 2;
+        const size_t mask = capacity - 1;
+
+        std::vector<uint32_t> table(capacity, empty_slot);
+        std::vector<uint32_t> remap(vertices.size());
+        uint32_t unique = 0;
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            size_t slot = hash_vertex(vertices[i]) & mask;
+            while (true)
+            {
+                const uint32_t entry = table[slot];
+                if (entry == empty_slot)
+                {
+                    // unique <= i,       
+                    vertices[unique] = vertices[i];
+                    table[slot] = unique;
+                    remap[i] = unique++;
+                    break;
+                }
+                if (std::memcmp(&vertices[entry], &vertices[i], sizeof(MeshVertex)) == 0)
+                {
+                    remap[i] = entry;
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+        }
+
+        vertices.resize(unique);
+        for (uint32_t& index : indices)
+            index = remap[index];
+    }
+
+    /*
+     *      ( ) -   
+     *   ,    .
+     */
+    void compute_missing_normals(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices)
+    {
+        std::vector<bool> missing(vertices.size());
+        bool any = false;
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            missing[i] = vertices[i].normal == glm::vec3(0.0f);
+            any = any || missing[i];
+        }
+        if (any == false)
+            return;
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const glm::vec3& a = vertices[indices[i]].position;
+            const glm::vec3& b = vertices[indices[i + 1]].position;
+            const glm::vec3& c = vertices[indices[i + 2]].position;
+            const glm::vec3 normal = glm::cross(b - a, c - a);     //     
+
+            for (size_t corner = 0; corner < 3; corner++)
+            {
+                if (missing[indices[i + corner]])
+                    vertices[indices[i + corner]].normal += normal;
+            }
+        }
+
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            const float length = glm::length(vertices[i].normal);
+            if (missing[i] && length > 0.0f)
+                vertices[i].normal /= length;
+        }
+    }
+
+    /*
+     *        (Tipsify, Sander, Nehab  Barczak, 2007).
+     *       "" .    ,
+     *          ,      .
+     *   ,        (dead-end )
+     *    .
+     *
+     *  clusters     ,     
+     *     -          ( optimize_overdraw()).
+     */
+    void optimize_vertex_cache(std::span<uint32_t> indices, size_t vertex_count, std::vector<uint32_t>& clusters)
+    {
+        const size_t triangle_count = indices.size() / 3;
+        clusters.clear();
+        if (triangle_count == 0)
+            return;
+
+        //     (CSR)
+        std::vector<uint32_t> live(vertex_count, 0);    //    
+        for (uint32_t index : indices)
+            live[index]++;
+
+        std::vector<uint32_t> offsets(vertex_count + 1, 0);
+        for (size_t v = 0; v < vertex_count; v++)
+            offsets[v + 1] = offsets[v] + live[v];
+
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+        std::vector<uint32_t> cache_time(vertex_count, 0);
+        std::vector<bool> emitted(triangle_count, false);
+        std::vector<uint32_t> dead_end;
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+
+        const uint32_t cache_size = vertex_cache_size;
+        uint32_t time = cache_size + 1;
+        size_t cursor = 0;          //       dead-end 
+        int64_t fan = 0;
+
+        while (fan >= 0)
+        {
+            const uint32_t focus = static_cast<uint32_t>(fan);
+            const uint32_t first_triangle = static_cast<uint32_t>(output.size() / 3);
+            if (time - cache_time[focus] > cache_size && (clusters.empty() || clusters.back() != first_triangle))
+                clusters.push_back(first_triangle);
+
+            candidates.clear();
+            for (uint32_t k = offsets[focus]; k < offsets[focus + 1]; k++)
+            {
+                const uint32_t triangle = adjacency[k];
+                if (emitted[triangle])
+                    continue;
+
+                for (size_t corner = 0; corner < 3; corner++)
+                {
+                    const uint32_t v = indices[triangle * 3 + corner];
+                    output.push_back(v);
+                    dead_end.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    if (time - cache_time[v] > cache_size)
+                        cache_time[v] = time++;
+                }
+                emitted[triangle] = true;
+            }
+
+            // -   ,          
+            fan = -1;
+            int64_t best = -1;
+            for (uint32_t v : candidates)
+            {
+                if (live[v] == 0)
+                    continue;
+
+                int64_t priority = 0;
+                if (time - cache_time[v] + 2 * live[v] <= cache_size)
+                    priority = time - cache_time[v];
+                if (priority > best)
+                {
+                    best = priority;
+                    fan = v;
+                }
+            }
+
+            while (fan < 0 && dead_end.empty() == false)
+            {
+                const uint32_t v = dead_end.back();
+                dead_end.pop_back();
+                if (live[v] > 0)
+                    fan = v;
+            }
+
+            while (fan < 0 && cursor < vertex_count)
+            {
+                if (live[cursor] > 0)
+                    fan = static_cast<int64_t>(cursor);
+                else
+                    cursor++;
+            }
+        }
+
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    /*
+     *     optimize_vertex_cache()  
+     * ( Sander  ., 2007).   ,  , 
+     *   -    .     
+     *             .
+     *      ,       .
+     */
+    void optimize_overdraw(std::span<uint32_t> indices, const std::vector<MeshVertex>& vertices,
+        const std::vector<uint32_t>& clusters)
+    {
+        const size_t triangle_count = indices.size() / 3;
+        if (clusters.size() < 2)
+            return;
+
+        struct Cluster
+        {
+            uint32_t first;
+            uint32_t end;
+            glm::vec3 center;
+            glm::vec3 normal;
+            float area;
+            float key;
+        };
+
+        std::vector<Cluster> groups(clusters.size());
+        glm::vec3 mesh_center = glm::vec3(0.0f);
+        float mesh_area = 0.0f;
+        for (size_t c = 0; c < clusters.size(); c++)
+        {
+            Cluster& group = groups[c];
+            group.first = clusters[c];
+            group.end = c + 1 < clusters.size() ? clusters[c + 1] : static_cast<uint32_t>(triangle_count);
+            group.center = glm::vec3(0.0f);
+            group.normal = glm::vec3(0.0f);
+            group.area = 0.0f;
+
+            for (uint32_t t = group.first; t < group.end; t++)
+            {
+                const glm::vec3& a = vertices[indices[t * 3]].position;
+                const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+                const glm::vec3& c3 = vertices[indices[t * 3 + 2]].position;
+                const glm::vec3 normal = glm::cross(b - a, c3 - a);
+                const float area = glm::length(normal);
+
+                group.center += (a + b + c3) * (area / 3.0f);
+                group.normal += normal;
+                group.area += area;
+            }
+
+            mesh_center += group.center;
+            mesh_area += group.area;
+            if (group.area > 0.0f)
+                group.center /= group.area;
+        }
+        if (mesh_area > 0.0f)
+            mesh_center /= mesh_area;
+
+        for (Cluster& group : groups)
+        {
+            const float length = glm::length(group.normal);
+            group.key = length > 0.0f ? glm::dot(group.center - mesh_center, group.normal / length) : 0.0f;
+        }
+
+        std::stable_sort(groups.begin(), groups.end(), [](const Cluster& a, const Cluster& b)
+            {
+                return a.key > b.key;
+            });
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        for (const Cluster& group : groups)
+            output.insert(output.end(), indices.begin() + group.first * 3, indices.begin() + group.end * 3);
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    /*
+     *           ,
+     *         .  .
+     */
+    void optimize_vertex_fetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        std::vector<uint32_t> remap(vertices.size(), empty_slot);
+        std::vector<MeshVertex> output;
+        output.reserve(vertices.size());
+
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == empty_slot)
+            {
+                remap[index] = static_cast<uint32_t>(output.size());
+                output.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+        vertices.swap(output);
+    }
+
+    /*
+     *          (Rossignac  Borrel, 1993).
+     *           ,   -   ,
+     *   ,     .     
+     * ,           .
+     * origin    .  -   .
+     */
+    float simplify_mesh(const std::vector<MeshVertex>& vertices, std::span<const uint32_t> indices,
+        const glm::vec3& origin, float cell_size, std::vector<uint32_t>& result)
+    {
+        constexpr uint32_t cell_limit = (1u << 21) - 1;     //  21     
+        auto cell_key = [&](const glm::vec3& position)
+            {
+                const glm::vec3 cell = glm::clamp(glm::floor((position - origin) / cell_size),
+                    glm::vec3(0.0f), glm::vec3(static_cast<float>(cell_limit)));
+                return (static_cast<uint64_t>(cell.x) << 42) | (static_cast<uint64_t>(cell.y) << 21) |
+                    static_cast<uint64_t>(cell.z);
+            };
+
+        //  ,   
+        std::vector<uint32_t> used(indices.begin(), indices.end());
+        std::sort(used.begin(), used.end());
+        used.erase(std::unique(used.begin(), used.end()), used.end());
+
+        std::vector<std::pair<uint64_t, uint32_t>> cells(used.size());
+        for (size_t i = 0; i < used.size(); i++)
+            cells[i] = { cell_key(vertices[used[i]].position), used[i] };
+        std::sort(cells.begin(), cells.end());
+
+        std::vector<uint32_t> remap(vertices.size(), empty_slot);
+        float error = 0.0f;
+        for (size_t first = 0; first < cells.size();)
+        {
+            size_t last = first;
+            glm::vec3 center = glm::vec3(0.0f);
+            while (last < cells.size() && cells[last].first == cells[first].first)
+                center += vertices[cells[last++].second].position;
+            center /= static_cast<float>(last - first);
+
+            uint32_t representative = cells[first].second;
+            float best = std::numeric_limits<float>::max();
+            for (size_t i = first; i < last; i++)
+            {
+                const glm::vec3 offset = vertices[cells[i].second].position - center;
+                const float distance = glm::dot(offset, offset);
+                if (distance < best)
+                {
+                    best = distance;
+                    representative = cells[i].second;
+                }
+            }
+
+            for (size_t i = first; i < last; i++)
+            {
+                remap[cells[i].second] = representative;
+                error = std::max(error, glm::distance(vertices[cells[i].second].position, vertices[representative].position));
+            }
+            first = last;
+        }
+
+        result.clear();
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const uint32_t a = remap[indices[i]];
+            const uint32_t b = remap[indices[i + 1]];
+            const uint32_t c = remap[indices[i + 2]];
+            if (a != b && b != c && a != c)
+            {
+                result.push_back(a);
+                result.push_back(b);
+                result.push_back(c);
+            }
+        }
+        return error;
+    }
+
+} // namespace cg
@@ -0,0 +1,26 @@
+#ifndef CG_MESH_OPTIMIZER
+#define CG_MESH_OPTIMIZER
+
+#include "mesh.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace cg
+{
+
+void deduplicate_vertices(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+void compute_missing_normals(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices);
+void optimize_vertex_cache(std::span<uint32_t> indices, size_t vertex_count, std::vector<uint32_t>& clusters);
+void optimize_overdraw(std::span<uint32_t> indices, const std::vector<MeshVertex>& vertices,
+    const std::vector<uint32_t>& clusters);
+void optimize_vertex_fetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+float simplify_mesh(const std::vector<MeshVertex>& vertices, std::span<const uint32_t> indices,
+    const glm::vec3& origin, float cell_size, std::vector<uint32_t>& result);
+
+} // namespace cg
+
+#endif
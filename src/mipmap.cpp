@@ -0,0 +1,228 @@
+#include "mipmap.h"
+#include "srgb.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <memory>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CG_MIPMAP_SSE2
+#endif
+
+namespace cg
+{
+    constexpr int rows_per_task = 32;       //    ,    
+
+    /*
+     *   function(first_row, last_row)    ,   .
+     */
+    static void for_each_row_chunk(int rows, const std::function<void(int, int)>& function)
+    {
+        const int chunks = (rows + rows_per_task - 1) / rows_per_task;
+        parallel_for(chunks, [rows, &function](int chunk)
+        {
+            const int first = chunk * rows_per_task;
+            function(first, std::min(first + rows_per_task, rows));
+        });
+    }
+
+    /*
+     * Box  2x2   sRGB    0   float .
+     *   0      float (16   ).
+     * x_step  0,     1.
+     */
+    static void downsample_row_srgb(const unsigned char* row0,
+        const unsigned char* row1,
+        float* out,
+        int out_width,
+        int x_step,
+        const SrgbTables& tables)
+    {
+        for (int x = 0; x < out_width; x++)
+        {
+            const unsigned char* a = row0 + x * 8;
+            const unsigned char* b = row1 + x * 8;
+            for (int c = 0; c < 3; c++)
+            {
+                out[x * 4 + c] = 0.25f * (tables.to_linear[a[c]] + tables.to_linear[a[x_step + c]] +
+                    tables.to_linear[b[c]] + tables.to_linear[b[x_step + c]]);
+            }
+            out[x * 4 + 3] = (a[3] + a[x_step + 3] + b[3] + b[x_step + 3]) / (4.0f * 255.0f);
+        }
+    }
+
+    /*
+     *    float    sRGB .
+     */
+    static void encode_row(const float* in, unsigned char* out, int width, const SrgbTables& tables)
+    {
+#ifdef CG_MIPMAP_SSE2
+        const __m128 scale = _mm_set_ps(255.0f, srgb_table_size - 1.0f, srgb_table_size - 1.0f, srgb_table_size - 1.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        alignas(16) int indices[4];
+
+        for (int x = 0; x < width; x++)
+        {
+            __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + x * 4), zero), one);
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_cvtps_epi32(_mm_mul_ps(value, scale)));
+
+            out[x * 4 + 0] = tables.to_srgb[indices[0]];
+            out[x * 4 + 1] = tables.to_srgb[indices[1]];
+            out[x * 4 + 2] = tables.to_srgb[indices[2]];
+            out[x * 4 + 3] = static_cast<unsigned char>(indices[3]);
+        }
+#else
+        for (int x = 0; x < width; x++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                out[x * 4 + c] = linear_to_srgb(tables, in[x * 4 + c]);
+            }
+            out[x * 4 + 3] = static_cast<unsigned char>(std::clamp(in[x * 4 + 3], 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+#endif
+    }
+
+    /*
+     * Box  2x2    .
+     * row0  row1    ,      2 * out_width.
+     * AVX2     , SSE2 -   (  = 4 float).
+     */
+    static void downsample_row(const float* row0, const float* row1, float* out, int out_width)
+    {
+        int x = 0;
+
+#if defined(__AVX2__)
+        const __m256 quarter8 = _mm256_set1_ps(0.25f);
+        for (; x + 2 <= out_width; x += 2)
+        {
+            const __m256 a = _mm256_add_ps(_mm256_loadu_ps(row0 + x * 8), _mm256_loadu_ps(row1 + x * 8));             //  2x, 2x+1
+            const __m256 b = _mm256_add_ps(_mm256_loadu_ps(row0 + x * 8 + 8), _mm256_loadu_ps(row1 + x * 8 + 8));     //  2x+2, 2x+3
+            const __m256 sum = _mm256_add_ps(_mm256_permute2f128_ps(a, b, 0x20), _mm256_permute2f128_ps(a, b, 0x31));
+            _mm256_storeu_ps(out + x * 4, _mm256_mul_ps(sum, quarter8));
+        }
+#endif
+
+#ifdef CG_MIPMAP_SSE2
+        const __m128 quarter = _mm_set1_ps(0.25f);
+        for (; x < out_width; x++)
+        {
+            const __m128 top = _mm_add_ps(_mm_loadu_ps(row0 + x * 8), _mm_loadu_ps(row0 + x * 8 + 4));
+            const __m128 bottom = _mm_add_ps(_mm_loadu_ps(row1 + x * 8), _mm_loadu_ps(row1 + x * 8 + 4));
+            _mm_storeu_ps(out + x * 4, _mm_mul_ps(_mm_add_ps(top, bottom), quarter));
+        }
+#else
+        for (; x < out_width; x++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                out[x * 4 + c] = 0.25f * (row0[x * 8 + c] + row0[x * 8 + 4 + c] +
+                    row1[x * 8 + c] + row1[x * 8 + 4 + c]);
+            }
+        }
+#endif
+    }
+
+    /*
+     * Box      1 (   ).
+     */
+    static void downsample_column(const float* row0, const float* row1, float* out)
+    {
+        for (int c = 0; c < 4; c++)
+            out[c] = 0.5f * (row0[c] + row1[c]);
+    }
+
+    /*
+     *       .
+     *  0     ,      
+     *   ,   .
+     */
+    void prepare_mip_chain(int width,
+        int height,
+        std::vector<unsigned char>& chain,
+        std::vector<MipLevel>& levels)
+    {
+        levels.clear();
+
+        size_t size = 0;
+        for (int w = width, h = height; ; w = std::max(1, w / 2), h = std::max(1, h / 2))
+        {
+            levels.push_back({ w, h, size });
+            size += static_cast<size_t>(w) * h * 4;
+            if (w == 1 && h == 1)
+                break;
+        }
+
+        chain.resize(size);
+    }
+
+    /*
+     *     0    prepare_mip_chain() .
+     *        2x2 box    .
+     *     /  .
+     *        .
+     */
+    void build_mip_chain(std::vector<unsigned char>& chain, const std::vector<MipLevel>& levels)
+    {
+        if (levels.size() < 2)
+            return;
+
+        const unsigned char* pixels = chain.data();
+
+        const SrgbTables& tables = srgb_tables();
+
+        /*
+         *        .
+         *     -        .
+         */
+        const size_t float_count = static_cast<size_t>(levels[1].width) * levels[1].height * 4;
+        std::unique_ptr<float[]> current(new float[float_count]);
+        std::unique_ptr<float[]> next(new float[float_count]);
+
+        for (size_t i = 1; i < levels.size(); i++)
+        {
+            const MipLevel& source = levels[i - 1];
+            const MipLevel& level = levels[i];
+
+            for_each_row_chunk(level.height, [&](int first, int last)
+            {
+                for (int y = first; y < last; y++)
+                {
+                    const int y0 = std::min(y * 2, source.height - 1);
+                    const int y1 = std::min(y * 2 + 1, source.height - 1);
+                    float* out = next.get() + static_cast<size_t>(y) * level.width * 4;
+
+                    if (i == 1)
+                    {
+                        downsample_row_srgb(pixels + static_cast<size_t>(y0) * source.width * 4,
+                            pixels + static_cast<size_t>(y1) * source.width * 4,
+                            out,
+                            level.width,
+                            source.width >= 2 ? 4 : 0,
+                            tables);
+                    }
+                    else
+                    {
+                        const float* row0 = current.get() + static_cast<size_t>(y0) * source.width * 4;
+                        const float* row1 = current.get() + static_cast<size_t>(y1) * source.width * 4;
+
+                        if (source.width >= 2)
+                            downsample_row(row0, row1, out, level.width);
+                        else
+                            downsample_column(row0, row1, out);
+                    }
+
+                    encode_row(out, chain.data() + level.offset + static_cast<size_t>(y) * level.width * 4, level.width, tables);
+                }
+            });
+
+            current.swap(next);
+        }
+    }
+
+} // namespace cg
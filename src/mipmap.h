@@ -0,0 +1,28 @@
+#ifndef CG_MIPMAP
+#define CG_MIPMAP
+
+#include <cstddef>
+#include <vector>
+
+namespace cg
+{
+
+/*
+ *    .
+ */
+struct MipLevel
+{
+    int width;          //   
+    int height;         //   
+    size_t offset;      //       
+};
+
+void prepare_mip_chain(int width,
+    int height,
+    std::vector<unsigned char>& chain,
+    std::vector<MipLevel>& levels);
+void build_mip_chain(std::vector<unsigned char>& chain, const std::vector<MipLevel>& levels);
+
+} // namespace cg
+
+#endif
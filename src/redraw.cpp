@@ -0,0 +1,57 @@
+#include "redraw.h"
+
+#include <GLFW/glfw3.h>
+
+#include <atomic>
+
+namespace cg
+{
+    /*
+     *   .
+     * ,    (,  ,  ,
+     *  ),    request_redraw().   ,
+     *     wait_for_redraw()      .
+     */
+    static std::atomic<int> g_pending_frames = 3;       // ImGui       
+    static std::atomic<bool> g_waiting = false;         //    
+
+    /*
+     *   frames    .
+     *        -  ,   .
+     */
+    void request_redraw(int frames)
+    {
+        int pending = g_pending_frames;
+        while (pending < frames && g_pending_frames.compare_exchange_weak(pending, frames) == false)
+            ;
+
+        if (g_waiting)
+            glfwPostEmptyEvent();
+    }
+
+    /*
+     *    .  false,      .
+     */
+    bool consume_redraw(void)
+    {
+        int pending = g_pending_frames;
+        while (pending > 0 && g_pending_frames.compare_exchange_weak(pending, pending - 1) == false)
+            ;
+        return pending > 0;
+    }
+
+    /*
+     *   .    ,   
+     * , request_redraw()       timeout ( ).
+     */
+    void wait_for_redraw(double timeout)
+    {
+        g_waiting = true;   //   -         
+        if (g_pending_frames > 0)
+            glfwPollEvents();
+        else
+            glfwWaitEventsTimeout(timeout);
+        g_waiting = false;
+    }
+
+} // namespace cg
@@ -0,0 +1,13 @@
+#ifndef CG_REDRAW
+#define CG_REDRAW
+
+namespace cg
+{
+
+void request_redraw(int frames = 1);
+bool consume_redraw(void);
+void wait_for_redraw(double timeout);
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,121 @@
+#include "render_queue.h"
+
+#include <algorithm>
+#include <array>
+
+namespace cg
+{
+    /*
+     *      ( -):
+     *
+     *   :  (2) | 0 |  (8) |  (16) |  (13) |  (24)
+     *   :    (2) | 1 |   (24) |  (8) |  (16) |  (13)
+     *
+     *             
+     * (-    ).      
+     * -    ,     .
+     */
+    constexpr int pass_bits = 2;
+    constexpr int program_bits = 8;
+    constexpr int material_bits = 16;
+    constexpr int mesh_bits = 13;
+    constexpr int depth_bits = 24;
+
+    constexpr int translucent_shift = 64 - pass_bits - 1;
+    constexpr int pass_shift = 64 - pass_bits;
+
+    static_assert(pass_bits + 1 + program_bits + material_bits + mesh_bits + depth_bits == 64,
+        "The sort key fields must fill 64 bits");
+
+    static std::vector<RenderItem> g_sort_buffer;     //    ,    
+
+    static uint64_t field(unsigned int value, int bits)
+    {
+        return static_cast<uint64_t>(value) & ((uint64_t(1) << bits) - 1);
+    }
+
+    /*
+     *     .
+     * depth    ,   [0, 1] (-   ).
+     */
+    uint64_t make_sort_key(RenderPass pass,
+        bool translucent,
+        unsigned int program,
+        unsigned int material,
+        unsigned int mesh,
+        float depth)
+    {
+        const unsigned int depth_max = (1u << depth_bits) - 1;
+        unsigned int quantized = static_cast<unsigned int>(std::clamp(depth, 0.0f, 1.0f) * depth_max);
+
+        uint64_t key = field(pass, pass_bits) << pass_shift;
+        if (translucent == false)
+        {
+            key |= field(program, program_bits) << (material_bits + mesh_bits + depth_bits);
+            key |= field(material, material_bits) << (mesh_bits + depth_bits);
+            key |= field(mesh, mesh_bits) << depth_bits;
+            key |= field(quantized, depth_bits);
+            return key;
+        }
+
+        key |= uint64_t(1) << translucent_shift;
+        key |= field(depth_max - quantized, depth_bits) << (program_bits + material_bits + mesh_bits);
+        key |= field(program, program_bits) << (material_bits + mesh_bits);
+        key |= field(material, material_bits) << mesh_bits;
+        key |= field(mesh, mesh_bits);
+        return key;
+    }
+
+    bool is_translucent_key(uint64_t key)
+    {
+        return ((key >> translucent_shift) & 1) != 0;
+    }
+
+    /*
+     *    -      
+     *        .
+     */
+    unsigned int get_key_program(uint64_t key)
+    {
+        const int shift = is_translucent_key(key) ? material_bits + mesh_bits : material_bits + mesh_bits + depth_bits;
+        return static_cast<unsigned int>(field(static_cast<unsigned int>(key >> shift), program_bits));
+    }
+
+    /*
+     *     LSD radix sort    (, O(n)  ).
+     * ,       (  
+     *    ),   .
+     */
+    void sort_render_queue(std::vector<RenderItem>& items)
+    {
+        if (items.size() < 2)
+            return;
+
+        g_sort_buffer.resize(items.size());
+        for (int byte = 0; byte < 8; byte++)
+        {
+            const int shift = byte * 8;
+
+            std::array<size_t, 256> offsets = {};
+            for (const RenderItem& item : items)
+                offsets[(item.key >> shift) & 0xFF]++;
+
+            //       -    
+            if (offsets[(items[0].key >> shift) & 0xFF] == items.size())
+                continue;
+
+            size_t sum = 0;
+            for (size_t& offset : offsets)
+            {
+                const size_t count = offset;
+                offset = sum;
+                sum += count;
+            }
+
+            for (const RenderItem& item : items)
+                g_sort_buffer[offsets[(item.key >> shift) & 0xFF]++] = item;
+            items.swap(g_sort_buffer);
+        }
+    }
+
+} // namespace cg
@@ -0,0 +1,39 @@
+#ifndef CG_RENDER_QUEUE
+#define CG_RENDER_QUEUE
+
+#include <cstdint>
+#include <vector>
+
+namespace cg
+{
+
+/*
+ *    - -   .
+ */
+enum RenderPass : unsigned int
+{
+    PASS_SCENE = 0,     //  (,   )
+};
+
+/*
+ *   :           .
+ */
+struct RenderItem
+{
+    uint64_t key;
+    uint32_t index;
+};
+
+uint64_t make_sort_key(RenderPass pass,
+    bool translucent,
+    unsigned int program,
+    unsigned int material,
+    unsigned int mesh,
+    float depth);
+bool is_translucent_key(uint64_t key);
+unsigned int get_key_program(uint64_t key);
+void sort_render_queue(std::vector<RenderItem>& items);
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,434 @@
+#include "glad/glad.h"
+
+#include "scene_target.h"
+#include "gl_resource.h"
+#include "gl_state.h"
+#include "redraw.h"
+#include "shader.h"
+#include "structs.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace cg
+{
+    constexpr const char* upscale_vertex_shader = "resources/shaders/upscale_v.glsl";
+    constexpr const char* upscale_fragment_shader = "resources/shaders/upscale_f.glsl";
+    constexpr float scale_hysteresis = 0.02f;   // -   ,    
+    constexpr float scale_damping = 0.25f;      //   ,      
+    constexpr int benchmark_warmup_frames = 8;  //     ,    
+    constexpr int benchmark_frames = 32;        //     
+
+    static const char* const g_anti_aliasing_names[AA_COUNT] = { "Off", "MSAA 2x", "MSAA 4x", "MSAA 8x", "FXAA" };
+
+    /*
+     *     GPU.
+     *      -,   ,     GPU.
+     */
+    struct TimerQuery
+    {
+        unsigned int query;
+        float scale;        // ,    
+        int benchmark_mode; //   ,     (-1 -  )
+        bool pending;       //  
+    };
+
+    /*
+     *     .
+     *           
+     *   GPU   (    ).
+     */
+    struct AntiAliasingBenchmark
+    {
+        bool running = false;
+        int mode = 0;                               //  
+        int frame = 0;                              //    
+        std::array<double, AA_COUNT> total_ms = {};
+        std::array<int, AA_COUNT> measured = {};    //     
+        std::array<int, AA_COUNT> samples = {};     //   
+    };
+
+    static GlFramebuffer g_multisample_framebuffer; //   multisample
+    static GlRenderbuffer g_color_buffer;
+    static GlRenderbuffer g_depth_buffer;
+    static GlFramebuffer g_resolve_framebuffer;     //   -   
+    static GlTexture g_resolve_texture;
+    static GlVertexArray g_empty_vao;               // Core   VAO   
+    static unsigned int g_framebuffer = 0;          // ,      (  )
+    static int g_upscale_program = -1;
+    static int g_fxaa_program = -1;                 //   FXAA
+
+    static glm::ivec2 g_capacity = glm::ivec2(0);   //    (=  )
+    static int g_samples = 0;                       //    
+    static int g_actual_samples = 0;                //     
+    static int g_anti_aliasing = AA_OFF;            //    
+    static glm::ivec2 g_window = glm::ivec2(1);
+    static glm::ivec2 g_resolution = glm::ivec2(1); //    
+    static float g_scale = 1.0f;
+    static float g_gpu_ms = 0.0f;
+
+    static std::array<TimerQuery, 4> g_queries = {};
+    static int g_query_index = 0;                   //   ( - )
+    static bool g_timing = false;                   //      
+    static AntiAliasingBenchmark g_benchmark;
+
+    /*
+     *       .
+     *      ,      .
+     */
+    void init_scene_target(void)
+    {
+        g_upscale_program = add_program(upscale_vertex_shader, upscale_fragment_shader);
+        g_fxaa_program = get_program_variant(upscale_vertex_shader, upscale_fragment_shader, SHADER_FXAA);
+        g_empty_vao = GlVertexArray::create();
+        for (TimerQuery& query : g_queries)
+            glCreateQueries(GL_TIME_ELAPSED, 1, &query.query);
+    }
+
+    static void release_buffers(void)
+    {
+        g_multisample_framebuffer.reset();
+        g_resolve_framebuffer.reset();
+        g_resolve_texture.reset();
+        g_color_buffer.reset();
+        g_depth_buffer.reset();
+
+        g_framebuffer = 0;
+        g_capacity = glm::ivec2(0);
+        g_samples = 0;
+        g_actual_samples = 0;
+    }
+
+    /*
+     *      ,   .
+     * FXAA    .
+     */
+    static int anti_aliasing_samples(int mode)
+    {
+        int samples = 1;
+        switch (mode)
+        {
+        case AA_MSAA_2: samples = 2; break;
+        case AA_MSAA_4: samples = 4; break;
+        case AA_MSAA_8: samples = 8; break;
+        default: break;
+        }
+
+        int max_samples = 1;
+        glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
+        return std::max(std::min(samples, max_samples), 1);
+    }
+
+    /*
+     *       (- ),    
+     *     .       .
+     *  multisample     renderbuffer-     .
+     *           .
+     */
+    static bool allocate_buffers(const glm::ivec2& size, int samples)
+    {
+        release_buffers();
+
+        g_resolve_texture = GlTexture(GL_TEXTURE_2D, 1, GL_RGBA8, size.x, size.y);
+        g_resolve_texture.set_sampling(GL_LINEAR, GL_LINEAR, GL_CLAMP_TO_EDGE);
+        g_depth_buffer = GlRenderbuffer(samples > 1 ? samples : 0, GL_DEPTH_COMPONENT24, size.x, size.y);
+
+        g_resolve_framebuffer = GlFramebuffer::create();
+        g_resolve_framebuffer.attach(GL_COLOR_ATTACHMENT0, g_resolve_texture);
+        if (samples == 1)
+            g_resolve_framebuffer.attach(GL_DEPTH_ATTACHMENT, g_depth_buffer);
+        bool complete = g_resolve_framebuffer.is_complete();
+
+        if (samples > 1)
+        {
+            g_color_buffer = GlRenderbuffer(samples, GL_RGBA8, size.x, size.y);
+            g_actual_samples = g_color_buffer.get_samples();
+
+            g_multisample_framebuffer = GlFramebuffer::create();
+            g_multisample_framebuffer.attach(GL_COLOR_ATTACHMENT0, g_color_buffer);
+            g_multisample_framebuffer.attach(GL_DEPTH_ATTACHMENT, g_depth_buffer);
+            complete = complete && g_multisample_framebuffer.is_complete();
+            g_framebuffer = g_multisample_framebuffer.id();
+        }
+        else
+        {
+            g_framebuffer = g_resolve_framebuffer.id();
+            g_actual_samples = 1;
+        }
+
+        if (complete == false)
+        {
+            std::cerr << "Failed to create the scene framebuffer (" << size.x << "x" << size.y
+                << ", " << samples << " samples)." << std::endl;
+            release_buffers();
+            g_capacity = size;      //          
+            g_samples = samples;
+            return false;
+        }
+
+        g_capacity = size;
+        g_samples = samples;
+        return true;
+    }
+
+    /*
+     *     .
+     *       , ..    .
+     * ,     ,    - 
+     *           .
+     */
+    static void update_scale(float gpu_ms, float measured_scale)
+    {
+        g_gpu_ms = gpu_ms;
+        if (resolution.dynamic == false || gpu_ms <= 0.0f)
+            return;
+
+        const float desired = measured_scale * std::sqrt(resolution.target_ms / gpu_ms);
+        if (std::abs(desired - g_scale) < scale_hysteresis)
+            return;
+        g_scale += (desired - g_scale) * scale_damping;
+    }
+
+    /*
+     *    ,  -  .
+     */
+    static void read_timer_queries(void)
+    {
+        for (int i = 0; i < static_cast<int>(g_queries.size()); i++)
+        {
+            TimerQuery& query = g_queries[(g_query_index + i) % g_queries.size()];
+            if (query.pending == false)
+                continue;
+
+            int available = 0;
+            glGetQueryObjectiv(query.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available == 0)
+                break;      // -    
+
+            uint64_t nanoseconds = 0;
+            glGetQueryObjectui64v(query.query, GL_QUERY_RESULT, &nanoseconds);
+            query.pending = false;
+            if (query.benchmark_mode >= 0)
+            {
+                g_benchmark.total_ms[query.benchmark_mode] += nanoseconds / 1.0e6;
+                g_benchmark.measured[query.benchmark_mode]++;
+            }
+            update_scale(static_cast<float>(nanoseconds / 1.0e6), query.scale);
+        }
+    }
+
+    static bool has_pending_benchmark_queries(void)
+    {
+        for (const TimerQuery& query : g_queries)
+            if (query.pending && query.benchmark_mode >= 0)
+                return true;
+        return false;
+    }
+
+    /*
+     *      -   GPU  
+     *      .
+     */
+    static void print_benchmark(void)
+    {
+        const double base_ms = g_benchmark.measured[AA_OFF] > 0 ?
+            g_benchmark.total_ms[AA_OFF] / g_benchmark.measured[AA_OFF] : 0.0;
+
+        std::cout << "Anti-aliasing benchmark (" << g_window.x << "x" << g_window.y << ", GPU time of scene, resolve and upscale):" << std::endl;
+        for (int mode = 0; mode < AA_COUNT; mode++)
+        {
+            if (g_benchmark.measured[mode] == 0)
+            {
+                std::cout << "  " << g_anti_aliasing_names[mode] << ": no results" << std::endl;
+                continue;
+            }
+
+            const double ms = g_benchmark.total_ms[mode] / g_benchmark.measured[mode];
+            std::cout << "  " << g_anti_aliasing_names[mode] << ": " << ms << " ms";
+            if (mode == AA_MSAA_2 || mode == AA_MSAA_4 || mode == AA_MSAA_8)
+                std::cout << " (" << g_benchmark.samples[mode] << " samples)";
+            if (mode != AA_OFF && base_ms > 0.0)
+                std::cout << ", " << ms / base_ms << "x of Off";
+            std::cout << std::endl;
+        }
+    }
+
+    /*
+     *      .
+     *  ,          .
+     *  ,       .
+     */
+    static int advance_benchmark(void)
+    {
+        if (g_benchmark.mode < AA_COUNT && g_benchmark.frame >= benchmark_warmup_frames + benchmark_frames)
+        {
+            g_benchmark.mode++;
+            g_benchmark.frame = 0;
+        }
+
+        if (g_benchmark.mode == AA_COUNT && has_pending_benchmark_queries() == false)
+        {
+            g_benchmark.running = false;
+            print_benchmark();
+            return resolution.anti_aliasing;
+        }
+
+        request_redraw();   //          
+        if (g_benchmark.mode == AA_COUNT)
+            return AA_OFF;  //    
+        g_benchmark.frame++;
+        return g_benchmark.mode;
+    }
+
+    /*
+     *     .
+     *             .
+     */
+    void begin_scene_target(int window_width, int window_height)
+    {
+        read_timer_queries();
+
+        g_anti_aliasing = std::clamp(resolution.anti_aliasing, 0, AA_COUNT - 1);
+        if (g_benchmark.running)
+            g_anti_aliasing = advance_benchmark();
+        const int samples = anti_aliasing_samples(g_anti_aliasing);
+
+        g_window = glm::max(glm::ivec2(window_width, window_height), glm::ivec2(1));
+        if (g_window != g_capacity || samples != g_samples)
+            allocate_buffers(g_window, samples);
+
+        const float min_scale = std::clamp(resolution.min_scale, 0.1f, 1.0f);
+        const float max_scale = std::clamp(resolution.max_scale, min_scale, 1.0f);
+        g_scale = resolution.dynamic ? std::clamp(g_scale, min_scale, max_scale) : max_scale;
+        if (g_benchmark.running)
+            g_scale = 1.0f;     //      
+        g_resolution = glm::clamp(glm::ivec2(glm::round(glm::vec2(g_window) * g_scale)), glm::ivec2(1), g_window);
+        if (g_framebuffer == 0)
+            g_resolution = g_window;
+
+        bind_framebuffer(GL_FRAMEBUFFER, g_framebuffer);   // 0 (),     
+        set_viewport(0, 0, g_resolution.x, g_resolution.y);
+
+        TimerQuery& query = g_queries[g_query_index];
+        g_timing = query.pending == false;      //  GPU     4 
+        if (g_timing)
+        {
+            glBeginQuery(GL_TIME_ELAPSED, query.query);
+            query.scale = g_scale;
+            query.benchmark_mode = -1;
+            if (g_benchmark.running && g_benchmark.mode < AA_COUNT && g_benchmark.frame > benchmark_warmup_frames)
+            {
+                query.benchmark_mode = g_benchmark.mode;
+                g_benchmark.samples[g_benchmark.mode] = g_actual_samples;
+            }
+        }
+    }
+
+    /*
+     *        ( FXAA,   ).
+     */
+    static void upscale_scene(void)
+    {
+        const unsigned int program = get_program(g_anti_aliasing == AA_FXAA ? g_fxaa_program : g_upscale_program);
+        if (program == 0)   //     -  
+        {
+            glBlitNamedFramebuffer(g_resolve_framebuffer.id(), 0,
+                0, 0, g_resolution.x, g_resolution.y,
+                0, 0, g_window.x, g_window.y,
+                GL_COLOR_BUFFER_BIT, GL_LINEAR);
+            return;
+        }
+
+        //        
+        const float sharpness = g_resolution == g_window ? 0.0f : resolution.sharpness;
+
+        bind_program(program);
+        glUniform2f(glGetUniformLocation(program, "u_uv_scale"),
+            static_cast<float>(g_resolution.x) / g_capacity.x,
+            static_cast<float>(g_resolution.y) / g_capacity.y);
+        glUniform2f(glGetUniformLocation(program, "u_texel"), 1.0f / g_capacity.x, 1.0f / g_capacity.y);
+        glUniform1f(glGetUniformLocation(program, "u_sharpness"), sharpness);
+        glUniform1i(glGetUniformLocation(program, "u_scene"), 0);
+        bind_texture(0, GL_TEXTURE_2D, g_resolve_texture.id());
+        bind_vertex_array(g_empty_vao.id());
+
+        set_capability(GL_DEPTH_TEST, false);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        set_capability(GL_DEPTH_TEST, true);
+    }
+
+    /*
+     *     :     
+     *    .         
+     *       .
+     *      ,    
+     *      .
+     */
+    void end_scene_target(void)
+    {
+        if (g_multisample_framebuffer)
+        {
+            glBlitNamedFramebuffer(g_multisample_framebuffer.id(), g_resolve_framebuffer.id(),
+                0, 0, g_resolution.x, g_resolution.y,
+                0, 0, g_resolution.x, g_resolution.y,
+                GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        }
+
+        bind_framebuffer(GL_FRAMEBUFFER, 0);
+        set_viewport(0, 0, g_window.x, g_window.y);
+        if (g_framebuffer != 0)     //       
+            upscale_scene();
+
+        if (g_timing)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+            g_queries[g_query_index].pending = true;
+            g_query_index = (g_query_index + 1) % g_queries.size();
+        }
+    }
+
+    /*
+     * ,        .
+     *    ,  ,    
+     * (  ,     ),    .
+     */
+    glm::ivec2 get_scene_resolution(void)
+    {
+        return g_resolution;
+    }
+
+    SceneTargetStats get_scene_target_stats(void)
+    {
+        return { g_scale, g_gpu_ms, g_resolution.x, g_resolution.y };
+    }
+
+    /*
+     *       .
+     *       
+     * (benchmark_warmup_frames + benchmark_frames) * AA_COUNT .
+     */
+    void start_anti_aliasing_benchmark(void)
+    {
+        g_benchmark = {};
+        g_benchmark.running = true;
+        request_redraw();
+    }
+
+    bool is_anti_aliasing_benchmark_running(void)
+    {
+        return g_benchmark.running;
+    }
+
+    void cleanup_scene_target(void)
+    {
+        release_buffers();
+        g_empty_vao.reset();
+        for (TimerQuery& query : g_queries)
+            glDeleteQueries(1, &query.query);
+        g_queries = {};
+    }
+
+} // namespace cg
@@ -0,0 +1,31 @@
+#ifndef CG_SCENE_TARGET
+#define CG_SCENE_TARGET
+
+#include <glm/glm.hpp>
+
+namespace cg
+{
+
+/*
+ *     ( ).
+ */
+struct SceneTargetStats
+{
+    float scale;        //    
+    float gpu_ms;       //       
+    int width;          // ,     
+    int height;
+};
+
+void init_scene_target(void);
+void begin_scene_target(int window_width, int window_height);
+void end_scene_target(void);
+glm::ivec2 get_scene_resolution(void);
+SceneTargetStats get_scene_target_stats(void);
+void start_anti_aliasing_benchmark(void);
+bool is_anti_aliasing_benchmark_running(void);
+void cleanup_scene_target(void);
+
+} // namespace cg
+
+#endif
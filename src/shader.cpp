@@ -0,0 +1,639 @@
+#include "glad/glad.h"
+
+#include "shader.h"
+#include "archive.h"
+#include "gl_ext.h"
+#include "gl_state.h"
+#include "redraw.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace cg
+{
+    /*
+     *  ,       .
+     *     ,   .
+     */
+    struct ProgramEntry
+    {
+        std::string vertex_path;            //   vertex  (  compute )
+        std::string fragment_path;          //   fragment  (  compute )
+        std::string vertex_source;          //   vertex 
+        std::string fragment_source;        //   fragment 
+        std::string defines;                // #define   
+        bool compute = false;               //    compute  ( vertex_source)
+
+        unsigned int program = 0;           //  ,   
+        unsigned int pending = 0;           // ,    
+        unsigned int pending_vertex = 0;    // Vertex   pending 
+        unsigned int pending_fragment = 0;  // Fragment   pending 
+    };
+
+    static std::vector<ProgramEntry> g_programs;
+    static std::unordered_map<std::string, int> g_variant_ids;     //    -> 
+    static unsigned int g_generation = 0;       //    
+    static bool g_parallel_compile = false;    //   GL_KHR_parallel_shader_compile
+    static std::string g_global_defines;        // #define ,    
+
+    /*
+     *   ,      .
+     */
+    static std::thread g_watcher;
+    static std::atomic<bool> g_watcher_running = false;
+    static std::mutex g_changed_mutex;
+    static std::unordered_map<std::string, std::string> g_changed_sources;     //  ->   
+
+    /*
+     *  ,      (preload_shader()).
+     */
+    static std::mutex g_preloaded_mutex;
+    static std::unordered_map<std::string, std::string> g_preloaded_sources;   //  ->  
+
+    /*
+     *   ,         inotify.
+     */
+    static std::string normalize_path(const std::filesystem::path& path)
+    {
+        return path.lexically_normal().generic_string();
+    }
+
+    /*
+     *           .
+     *      preload_shader(),   .
+     *    string.
+     */
+    static std::optional<std::string> read_shader(const std::string& path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_preloaded_mutex);
+            auto it = g_preloaded_sources.find(normalize_path(path));
+            if (it != g_preloaded_sources.end())
+            {
+                std::string source = std::move(it->second);
+                g_preloaded_sources.erase(it);
+                return source;
+            }
+        }
+
+        Resource resource;
+        if (open_resource(path, resource) == false)
+            return std::nullopt;
+
+        std::string result(reinterpret_cast<const char*>(resource.data.data()), resource.data.size());
+        close_resource(resource);
+        return result;
+    }
+
+    /*
+     *       #define .
+     */
+    static std::string variant_defines(unsigned int variant)
+    {
+        std::string defines = g_global_defines;
+        if (variant & SHADER_LIT)
+            defines += "#define LIGHTING_PHONG 1\n";
+        if (variant & SHADER_TEXTURED)
+            defines += "#define TEXTURED 1\n";
+        if (variant & SHADER_FXAA)
+            defines += "#define FXAA 1\n";
+
+        return defines;
+    }
+
+    /*
+     *   #define   #version,     .
+     */
+    static std::string inject_defines(const std::string& source, const std::string& defines)
+    {
+        if (defines.empty())
+            return source;
+
+        size_t version = source.find("#version");
+        if (version == std::string::npos)
+            return defines + source;
+
+        size_t line_end = source.find('\n', version);
+        if (line_end == std::string::npos)
+            return source + "\n" + defines;
+
+        return source.substr(0, line_end + 1) + defines + source.substr(line_end + 1);
+    }
+
+    /*
+     *     .
+     *    ,     .
+     */
+    static unsigned int submit_shader(const std::string& shader_source, unsigned int type)
+    {
+        unsigned int shader = glCreateShader(type);
+
+        const char* c_str = shader_source.c_str();
+        glShaderSource(shader, 1, &c_str, nullptr);
+        glCompileShader(shader);
+
+        return shader;
+    }
+
+    /*
+     *       ,   .
+     */
+    static void print_shader_log(unsigned int shader, unsigned int type)
+    {
+        int is_compiled = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &is_compiled);
+        if (is_compiled != 0)
+            return;
+
+        std::string log;
+        int length = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        log.resize(length);
+        glGetShaderInfoLog(shader, length, nullptr, &log[0]);
+
+        std::string type_s = type == GL_VERTEX_SHADER ? "vertex" :
+            type == GL_COMPUTE_SHADER ? "compute" : "fragment";
+        std::cerr << "Failed to compile " << type_s << " shader." << std::endl;
+        std::cerr << log << std::endl;
+    }
+
+    /*
+     *   ,     .
+     */
+    static void discard_pending(ProgramEntry& entry)
+    {
+        if (entry.pending == 0)
+            return;
+
+        glDeleteShader(entry.pending_vertex);
+        glDeleteShader(entry.pending_fragment);
+        delete_program(entry.pending);
+
+        entry.pending = 0;
+        entry.pending_vertex = 0;
+        entry.pending_fragment = 0;
+    }
+
+    /*
+     *       .
+     *  GL_KHR_parallel_shader_compile     ,
+     *        update_programs().
+     */
+    static void submit_program(ProgramEntry& entry)
+    {
+        discard_pending(entry);     // -   
+
+        if (entry.compute)
+        {
+            entry.pending_vertex = submit_shader(inject_defines(entry.vertex_source, entry.defines),
+                GL_COMPUTE_SHADER);
+            entry.pending = glCreateProgram();
+            glAttachShader(entry.pending, entry.pending_vertex);
+            glLinkProgram(entry.pending);
+            return;
+        }
+
+        entry.pending_vertex = submit_shader(inject_defines(entry.vertex_source, entry.defines),
+            GL_VERTEX_SHADER);
+        entry.pending_fragment = submit_shader(inject_defines(entry.fragment_source, entry.defines),
+            GL_FRAGMENT_SHADER);
+
+        entry.pending = glCreateProgram();
+        glAttachShader(entry.pending, entry.pending_vertex);
+        glAttachShader(entry.pending, entry.pending_fragment);
+        glLinkProgram(entry.pending);
+    }
+
+    /*
+     *   pending   .
+     *         
+     * update_programs(),         .
+     */
+    static bool is_pending_complete(const ProgramEntry& entry)
+    {
+        if (g_parallel_compile == false)
+            return true;
+
+        int is_complete = 0;
+        glGetProgramiv(entry.pending, GL_COMPLETION_STATUS_KHR, &is_complete);
+        return is_complete != 0;
+    }
+
+    /*
+     *   .
+     *      ,    .
+     */
+    static void finish_program(ProgramEntry& entry)
+    {
+        int is_linked = 0;
+        glGetProgramiv(entry.pending, GL_LINK_STATUS, &is_linked);
+        if (is_linked == 0)
+        {
+            print_shader_log(entry.pending_vertex, entry.compute ? GL_COMPUTE_SHADER : GL_VERTEX_SHADER);
+            if (entry.compute == false)
+                print_shader_log(entry.pending_fragment, GL_FRAGMENT_SHADER);
+
+            std::string log;
+            int length = 0;
+            glGetProgramiv(entry.pending, GL_INFO_LOG_LENGTH, &length);
+            log.resize(length);
+            glGetProgramInfoLog(entry.pending, length, nullptr, &log[0]);
+
+            std::cerr << "Failed to link program " << entry.vertex_path <<
+                (entry.compute ? "" : " + " + entry.fragment_path) << "." << std::endl;
+            std::cerr << log << std::endl;
+
+            discard_pending(entry);
+            return;
+        }
+
+        glDetachShader(entry.pending, entry.pending_vertex);   //   
+        if (entry.compute == false)
+            glDetachShader(entry.pending, entry.pending_fragment);
+        glDeleteShader(entry.pending_vertex);                   //     
+        glDeleteShader(entry.pending_fragment);
+
+        if (entry.program != 0)
+            delete_program(entry.program);     //    ,     
+
+        entry.program = entry.pending;
+        entry.pending = 0;
+        g_generation++;
+        entry.pending_vertex = 0;
+        entry.pending_fragment = 0;
+    }
+
+    /*
+     *     .
+     *       ,    .
+     */
+    void init_shaders(void)
+    {
+        g_parallel_compile = glMaxShaderCompilerThreadsKHR != nullptr;
+        if (g_parallel_compile)
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        else
+            std::cout << "GL_KHR_parallel_shader_compile is not available, " <<
+                "shader status checks are deferred." << std::endl;
+    }
+
+    /*
+     *   #define,     (    ).
+     *         .
+     */
+    void add_shader_define(const std::string& name)
+    {
+        g_global_defines += "#define " + name + " 1\n";
+    }
+
+    /*
+     *    .   OpenGL,     
+     *        .
+     *  ,   ,   .
+     */
+    bool preload_shader(const std::string& path)
+    {
+        const auto source = read_shader(path);
+        if (source.has_value() == false)
+        {
+            std::cerr << "Failed to read shader " << path << "." << std::endl;
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(g_preloaded_mutex);
+        g_preloaded_sources[normalize_path(path)] = source.value();
+        return true;
+    }
+
+    /*
+     *    .
+     *          .
+     *    get_program()  -1  .
+     */
+    int add_program(const std::string& vertex_path, const std::string& fragment_path)
+    {
+        const auto vertex_source = read_shader(vertex_path);
+        const auto fragment_source = read_shader(fragment_path);
+        if (vertex_source.has_value() == false ||
+            fragment_source.has_value() == false)
+        {
+            std::cerr << "Failed to read shaders." << std::endl;
+            return -1;
+        }
+
+        ProgramEntry entry;
+        entry.vertex_path = normalize_path(vertex_path);
+        entry.fragment_path = normalize_path(fragment_path);
+        entry.vertex_source = vertex_source.value();
+        entry.fragment_source = fragment_source.value();
+        submit_program(entry);
+
+        g_programs.push_back(std::move(entry));
+        return static_cast<int>(g_programs.size()) - 1;
+    }
+
+    /*
+     *   compute .    ,  add_program(),
+     *        .
+     *    get_program()  -1  .
+     */
+    int add_compute_program(const std::string& path)
+    {
+        const auto source = read_shader(path);
+        if (source.has_value() == false)
+        {
+            std::cerr << "Failed to read shaders." << std::endl;
+            return -1;
+        }
+
+        ProgramEntry entry;
+        entry.vertex_path = normalize_path(path);
+        entry.vertex_source = source.value();
+        entry.defines = g_global_defines;
+        entry.compute = true;
+        submit_program(entry);
+
+        g_programs.push_back(std::move(entry));
+        return static_cast<int>(g_programs.size()) - 1;
+    }
+
+    /*
+     *      .
+     *          ( ),
+     *       .         .
+     */
+    int get_program_variant(const std::string& vertex_path,
+        const std::string& fragment_path,
+        unsigned int variant)
+    {
+        const std::string vertex = normalize_path(vertex_path);
+        const std::string fragment = normalize_path(fragment_path);
+        const std::string key = vertex + "|" + fragment + "|" + std::to_string(variant);
+
+        auto it = g_variant_ids.find(key);
+        if (it != g_variant_ids.end())
+            return it->second;
+
+        ProgramEntry entry;
+        entry.vertex_path = vertex;
+        entry.fragment_path = fragment;
+        entry.defines = variant_defines(variant);
+
+        //          
+        for (const ProgramEntry& other : g_programs)
+        {
+            if (other.compute == false && other.vertex_path == vertex && other.fragment_path == fragment)
+            {
+                entry.vertex_source = other.vertex_source;
+                entry.fragment_source = other.fragment_source;
+                break;
+            }
+        }
+
+        if (entry.vertex_source.empty() || entry.fragment_source.empty())
+        {
+            const auto vertex_source = read_shader(vertex);
+            const auto fragment_source = read_shader(fragment);
+            if (vertex_source.has_value() == false ||
+                fragment_source.has_value() == false)
+            {
+                std::cerr << "Failed to read shaders." << std::endl;
+                g_variant_ids[key] = -1;    //     
+                return -1;
+            }
+            entry.vertex_source = vertex_source.value();
+            entry.fragment_source = fragment_source.value();
+        }
+
+        submit_program(entry);
+        g_programs.push_back(std::move(entry));
+
+        int id = static_cast<int>(g_programs.size()) - 1;
+        g_variant_ids[key] = id;
+        return id;
+    }
+
+    /*
+     *     0,      .
+     */
+    unsigned int get_program(int id)
+    {
+        if (id < 0 || id >= static_cast<int>(g_programs.size()))
+            return 0;
+        return g_programs[id].program;
+    }
+
+    /*
+     *      .
+     *        get_program()  0.
+     */
+    bool is_program_pending(int id)
+    {
+        if (id < 0 || id >= static_cast<int>(g_programs.size()))
+            return false;
+        return g_programs[id].pending != 0;
+    }
+
+    /*
+     * ,        .
+     *    (  uniform )  ,
+     *        .
+     */
+    unsigned int get_programs_generation(void)
+    {
+        return g_generation;
+    }
+
+    /*
+     *       .
+     *          watcher-.
+     */
+    void update_programs(void)
+    {
+        bool pending = false;
+        for (ProgramEntry& entry : g_programs)
+        {
+            if (entry.pending != 0 && is_pending_complete(entry))
+            {
+                finish_program(entry);
+                request_redraw();
+            }
+            pending = pending || entry.pending != 0;
+        }
+        if (pending)
+            request_redraw();   //      
+
+        std::unordered_map<std::string, std::string> changed;
+        {
+            std::lock_guard<std::mutex> lock(g_changed_mutex);
+            changed.swap(g_changed_sources);
+        }
+
+        for (const auto& [path, source] : changed)
+        {
+            for (ProgramEntry& entry : g_programs)
+            {
+                bool is_used = false;
+                if (entry.vertex_path == path)
+                {
+                    entry.vertex_source = source;
+                    is_used = true;
+                }
+                if (entry.fragment_path == path)
+                {
+                    entry.fragment_source = source;
+                    is_used = true;
+                }
+
+                if (is_used)
+                {
+                    std::cout << "Reloading " << path << std::endl;
+                    submit_program(entry);
+                }
+            }
+        }
+    }
+
+    /*
+     *    .
+     */
+    void cleanup_shaders(void)
+    {
+        for (ProgramEntry& entry : g_programs)
+        {
+            discard_pending(entry);
+            if (entry.program != 0)
+                delete_program(entry.program);
+        }
+        g_programs.clear();
+        g_variant_ids.clear();
+
+        std::lock_guard<std::mutex> lock(g_preloaded_mutex);
+        g_preloaded_sources.clear();
+    }
+
+#ifdef __linux__
+    /*
+     *     ,     .
+     *    hot-reload,      -  .
+     */
+    static std::optional<std::string> read_shader_file(const std::string& path)
+    {
+        std::string result;
+
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (in.good() == false)
+            return std::nullopt;
+
+        in.seekg(0, std::ios::end);
+        std::streamoff size = in.tellg();
+
+        if (size == -1)
+            return std::nullopt;
+
+        result.resize(static_cast<size_t>(size));
+        in.seekg(0, std::ios::beg);
+        in.read(&result[0], size);
+
+        return result;
+    }
+
+    /*
+     *         .
+     *       ,      .
+     */
+    static void watch_directory(std::string directory)
+    {
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd == -1)
+        {
+            std::cerr << "Failed to initialize inotify." << std::endl;
+            return;
+        }
+
+        if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+        {
+            std::cerr << "Failed to watch " << directory << "." << std::endl;
+            close(fd);
+            return;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+        while (g_watcher_running)
+        {
+            pollfd descriptor = { fd, POLLIN, 0 };
+            if (poll(&descriptor, 1, 100) <= 0)     // ,      
+                continue;
+
+            ssize_t length = read(fd, buffer, sizeof(buffer));
+            for (char* it = buffer; it < buffer + length; )
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(it);
+                it += sizeof(inotify_event) + event->len;
+
+                if (event->len == 0)
+                    continue;
+
+                const std::string path = normalize_path(std::filesystem::path(directory) / event->name);
+                auto source = read_shader_file(path);
+                if (source.has_value() == false)
+                    continue;
+
+                {
+                    std::lock_guard<std::mutex> lock(g_changed_mutex);
+                    g_changed_sources[path] = std::move(source.value());
+                }
+                request_redraw();
+            }
+        }
+
+        close(fd);
+    }
+#endif
+
+    /*
+     *        (hot-reload).
+     *   (     )     
+     *     .
+     */
+    void start_shader_watcher(const std::string& directory)
+    {
+        std::error_code error;
+        if (std::filesystem::is_directory(directory, error) == false)
+            return;
+
+#ifdef __linux__
+        if (g_watcher_running)
+            return;
+
+        g_watcher_running = true;
+        g_watcher = std::thread(watch_directory, directory);
+#else
+        std::cout << "Shader hot-reload is only supported on Linux." << std::endl;
+#endif
+    }
+
+    /*
+     *     .
+     */
+    void stop_shader_watcher(void)
+    {
+        g_watcher_running = false;
+        if (g_watcher.joinable())
+            g_watcher.join();
+    }
+
+} // namespace cg
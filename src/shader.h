@@ -0,0 +1,40 @@
+#ifndef CG_SHADER
+#define CG_SHADER
+
+#include <string>
+
+namespace cg
+{
+
+/*
+ *    .
+ *      #define,     #version,
+ *   fragment    .
+ */
+enum ShaderVariantFlags : unsigned int
+{
+    SHADER_LIT = 1u << 0,       // Phong  (  - )
+    SHADER_TEXTURED = 1u << 1,  //     
+    SHADER_FXAA = 1u << 2,      // FXAA    
+};
+
+void init_shaders(void);
+void add_shader_define(const std::string& name);
+bool preload_shader(const std::string& path);
+int add_program(const std::string& vertex_path, const std::string& fragment_path);
+int add_compute_program(const std::string& path);
+int get_program_variant(const std::string& vertex_path,
+    const std::string& fragment_path,
+    unsigned int variant);
+unsigned int get_program(int id);
+bool is_program_pending(int id);
+unsigned int get_programs_generation(void);
+void update_programs(void);
+void cleanup_shaders(void);
+
+void start_shader_watcher(const std::string& directory);
+void stop_shader_watcher(void);
+
+} // namespace cg
+
+#endif
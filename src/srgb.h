@@ -0,0 +1,55 @@
+#ifndef CG_SRGB
+#define CG_SRGB
+
+#include <algorithm>
+#include <cmath>
+
+namespace cg
+{
+
+constexpr int srgb_table_size = 4096;   //     (12 )
+
+/*
+ *     sRGB   .
+ *   sRGB      - .
+ *     ,       texconv.
+ */
+struct SrgbTables
+{
+    float to_linear[256];
+    unsigned char to_srgb[srgb_table_size];
+};
+
+inline const SrgbTables& srgb_tables(void)
+{
+    static const SrgbTables tables = []
+    {
+        SrgbTables result;
+        for (int i = 0; i < 256; i++)
+        {
+            const float c = i / 255.0f;
+            result.to_linear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < srgb_table_size; i++)
+        {
+            const float l = i / static_cast<float>(srgb_table_size - 1);
+            const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            result.to_srgb[i] = static_cast<unsigned char>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+        return result;
+    }();
+
+    return tables;
+}
+
+/*
+ *    [0, 1]   sRGB .
+ */
+inline unsigned char linear_to_srgb(const SrgbTables& tables, float value)
+{
+    return tables.to_srgb[static_cast<int>(std::clamp(value, 0.0f, 1.0f) * (srgb_table_size - 1) + 0.5f)];
+}
+
+} // namespace cg
+
+#endif
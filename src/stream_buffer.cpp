@@ -0,0 +1,195 @@
+#include "glad/glad.h"
+
+#include "stream_buffer.h"
+#include "gl_resource.h"
+#include "gl_state.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace cg
+{
+    /*
+     *    ,      (, , ).
+     *    glBufferStorage(),      CPU  
+     *  stream_regions  -    .      fence ,
+     *   CPU      GPU      stream_regions .
+     *            .
+     */
+    constexpr int stream_regions = 3;
+    constexpr size_t initial_region_size = 4 * 1024 * 1024;     // 4 MB  
+    constexpr size_t min_alignment = 16;                        // vec4  std140/std430
+    constexpr uint64_t wait_timeout = 1000000;                  // 1 ms  
+
+    /*
+     * ,   -.  ,  GPU   ,    .
+     */
+    struct RetiredBuffer
+    {
+        GlBuffer buffer;
+        int frame;
+    };
+
+    static GlBuffer g_buffer;
+    static unsigned char* g_memory = nullptr;
+    static size_t g_region_size = 0;
+    static std::array<GLsync, stream_regions> g_fences = {};
+    static int g_frame = 0;
+    static size_t g_used = 0;                   //     
+    static std::vector<RetiredBuffer> g_retired;
+
+    static size_t g_uniform_alignment = min_alignment;
+    static size_t g_storage_alignment = min_alignment;
+    static StreamBufferStats g_stats = {};
+
+    /*
+     *     stream_regions   region_size .
+     */
+    static bool create_buffer(size_t region_size)
+    {
+        const size_t size = region_size * stream_regions;
+        const unsigned int flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        GlBuffer buffer(size, nullptr, flags);
+        void* memory = buffer.map(0, size, flags);
+        if (memory == nullptr)
+        {
+            std::cerr << "Failed to map the stream buffer (" << size / 1024 << " KB)." << std::endl;
+            return false;
+        }
+
+        g_buffer = std::move(buffer);
+        g_memory = static_cast<unsigned char*>(memory);
+        g_region_size = region_size;
+        return true;
+    }
+
+    /*
+     *     ,      .
+     */
+    static size_t target_alignment(unsigned int target)
+    {
+        switch (target)
+        {
+        case GL_UNIFORM_BUFFER: return g_uniform_alignment;
+        case GL_SHADER_STORAGE_BUFFER: return g_storage_alignment;
+        default: return min_alignment;
+        }
+    }
+
+    void init_stream_buffer(void)
+    {
+        int alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        g_uniform_alignment = std::max(min_alignment, static_cast<size_t>(alignment));
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        g_storage_alignment = std::max(min_alignment, static_cast<size_t>(alignment));
+
+        create_buffer(initial_region_size);
+    }
+
+    /*
+     *   :  GPU     .
+     *  stream_regions  CPU    GPU   
+     *   fence    .
+     */
+    void begin_stream_frame(void)
+    {
+        GLsync& fence = g_fences[g_frame % stream_regions];
+        if (fence != nullptr)
+        {
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                g_stats.waits++;
+                do
+                    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait_timeout);
+                while (result == GL_TIMEOUT_EXPIRED);
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        // Fence      stream_regions  -      
+        std::erase_if(g_retired, [](const RetiredBuffer& retired)
+            {
+                return g_frame - retired.frame >= stream_regions;
+            });
+
+        g_used = 0;
+    }
+
+    /*
+     *   size    ,   target
+     * (GL_UNIFORM_BUFFER, GL_SHADER_STORAGE_BUFFER, GL_DRAW_INDIRECT_BUFFER  ..).
+     *    ,     -.   ,
+     *  GPU   ,         .
+     */
+    StreamAllocation allocate_stream(unsigned int target, size_t size)
+    {
+        if (size == 0 || g_memory == nullptr)
+            return { nullptr, g_buffer.id(), 0, 0 };
+
+        const size_t alignment = target_alignment(target);
+        size_t offset = (g_used + alignment - 1) / alignment * alignment;
+        if (offset + size > g_region_size)
+        {
+            size_t region_size = g_region_size * 2;
+            while (region_size < size)
+                region_size *= 2;
+
+            GlBuffer old_buffer = std::move(g_buffer);
+            if (create_buffer(region_size) == false)
+            {
+                g_buffer = std::move(old_buffer);
+                return { nullptr, g_buffer.id(), 0, 0 };
+            }
+
+            std::cout << "Stream buffer grown to " << region_size / 1024 << " KB per frame." << std::endl;
+            g_retired.push_back({ std::move(old_buffer), g_frame });
+            offset = 0;
+        }
+
+        const size_t region_offset = (g_frame % stream_regions) * g_region_size;
+        g_used = offset + size;
+        return { g_memory + region_offset + offset, g_buffer.id(), region_offset + offset, size };
+    }
+
+    /*
+     *   : fence   ,   .
+     */
+    void end_stream_frame(void)
+    {
+        g_fences[g_frame % stream_regions] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        g_stats.region_size = g_region_size;
+        g_stats.used = g_used;
+        g_frame++;
+    }
+
+    StreamBufferStats get_stream_buffer_stats(void)
+    {
+        return g_stats;
+    }
+
+    void cleanup_stream_buffer(void)
+    {
+        for (GLsync& fence : g_fences)
+        {
+            if (fence != nullptr)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        g_retired.clear();
+
+        //        
+        g_buffer.reset();
+        g_memory = nullptr;
+        g_region_size = 0;
+        g_stats = {};
+    }
+
+} // namespace cg
@@ -0,0 +1,41 @@
+#ifndef CG_STREAM_BUFFER
+#define CG_STREAM_BUFFER
+
+#include <cstddef>
+
+namespace cg
+{
+
+/*
+ *    ,    .
+ *         -  glBufferData()
+ *     .      .
+ */
+struct StreamAllocation
+{
+    void* data;             //    (nullptr  size == 0)
+    unsigned int buffer;    //   bind_buffer_range()
+    size_t offset;          //   
+    size_t size;            //   
+};
+
+/*
+ *     ( ).
+ */
+struct StreamBufferStats
+{
+    size_t region_size;     //    
+    size_t used;            //    
+    int waits;              // ,   CPU   GPU   
+};
+
+void init_stream_buffer(void);
+void begin_stream_frame(void);
+StreamAllocation allocate_stream(unsigned int target, size_t size);
+void end_stream_frame(void);
+StreamBufferStats get_stream_buffer_stats(void);
+void cleanup_stream_buffer(void);
+
+} // namespace cg
+
+#endif
@@ -53,4 +53,28 @@ namespace cg {
      *           .
      */
     Robot robot;
-}
\ No newline at end of file
+
+    /*
+     *   .
+     *       .
+     */
+    Crowd crowd;
+
+    /*
+     *   .
+     *         .
+     */
+    Lighting lighting;
+
+    /*
+     *   .
+     *            .
+     */
+    Redraw redraw;
+
+    /*
+     *   .
+     *         16.7 ms (60 Hz).
+     */
+    Resolution resolution;
+}
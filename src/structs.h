@@ -77,6 +77,84 @@ struct Robot {
     float head_bob = 0.0f;         //    
     float antenna_wiggle = 0.0f;   //   
     float walk_speed = 2.0f;       //      
+    bool walking = true;           //   (    )
+};
+
+/*
+ *     .
+ *            .
+ */
+struct Crowd {
+    int count = 0;              //   
+    int teams = 4;              //   (    )
+    float spacing = 2.0f;       //     
+};
+
+/*
+ *      .
+ *        ( lighting.h).
+ */
+struct Lighting {
+    bool robot_lights = true;   //     
+    float radius = 1.5f;        //    
+    float intensity = 1.0f;     //   
+};
+
+/*
+ *     .
+ *          ,    
+ *     ( redraw.h).
+ */
+struct Redraw {
+    bool on_demand = true;      //     (  )
+    float idle_timeout = 1.0f;  // -     
+};
+
+/*
+ *    (-)  .
+ * MSAA   multisample ,     .
+ * FXAA         .
+ */
+enum AntiAliasing {
+    AA_OFF = 0,         //  
+    AA_MSAA_2 = 1,      // 2   
+    AA_MSAA_4 = 2,      // 4   
+    AA_MSAA_8 = 3,      // 8   
+    AA_FXAA = 4,        //   
+    AA_COUNT = 5
+};
+
+/*
+ *      .
+ *      ,      min_scale  max_scale
+ *    ,       GPU    target_ms
+ * ( scene_target.h).      .
+ */
+struct Resolution {
+    bool dynamic = true;        //     (  max_scale)
+    float min_scale = 0.5f;     // -   
+    float max_scale = 1.0f;     // -   
+    float target_ms = 14.0f;    //       GPU  
+    float sharpness = 0.25f;    //    (0 -  )
+    int anti_aliasing = AA_MSAA_4;  //    (AntiAliasing)
+};
+
+/*
+ *   .
+ *          .
+ */
+enum RobotPart {
+    PART_BODY = 0,      // 
+    PART_HEAD = 1,      // 
+    PART_ARM = 2,       // 
+    PART_LEG = 3,       // 
+    PART_EYE = 4,       // 
+    PART_ANTENNA = 5,   // 
+    PART_SHOULDER = 6,  // 
+    PART_HIP = 7,       // 
+    PART_FOREARM = 8,   // 
+    PART_SHIN = 9,      // 
+    PART_COUNT = 10
 };
 
 /*
@@ -90,6 +168,10 @@ namespace cg {
     extern Camera camera;               //   
     extern Perspective perspective;     //   
     extern Robot robot;                 //   
+    extern Crowd crowd;                 //     
+    extern Lighting lighting;           //    
+    extern Redraw redraw;               //   
+    extern Resolution resolution;       //    
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,1292 @@
+#include "glad/glad.h"
+
+#include "archive.h"
+#include "gl_ext.h"
+#include "gl_resource.h"
+#include "gl_state.h"
+#include "image_decoder.h"
+#include "mipmap.h"
+#include "redraw.h"
+#include "srgb.h"
+#include "texture.h"
+#include "texture_format.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cg
+{
+    /*
+     * ,    .
+     *       (GL) .
+     *
+     *  bindless   GPU        base_level .
+     *    (stream in)   (eviction)    
+     *     ,       glCopyImageSubData.
+     */
+    struct TextureEntry
+    {
+        std::string path;                   //   
+        GlTexture texture;                  // OpenGL ,     (    )
+        uint64_t handle = 0;                // Bindless handle (0  GL_ARB_bindless_texture)
+        int layer = -1;                     //      ( GL_ARB_bindless_texture)
+        int width = 0;                      //    0  
+        int height = 0;                     //    0  
+        int level_count = 0;                //     
+        unsigned int internal_format = GL_RGBA8;
+        int base_level = 0;                 // -   texture
+        size_t resident_bytes = 0;          // GPU ,   texture (  )
+        bool ready = false;                 //     
+
+        /*
+         *  -    mark_texture_used()    .
+         */
+        int last_used = -1;                 // ,       
+        float screen_size = 0.0f;           // -       ()
+        int wanted_level = 0;               // - ,    
+
+        /*
+         *   .
+         */
+        bool loading = false;               //     
+        bool failed = false;                //      
+        int retry_frame = 0;                // ,         
+        std::vector<unsigned char> pixels;  //    (RGBA)
+        std::vector<MipLevel> levels;       //   
+        Resource compressed;                // .cgtex        (  )
+        GlTexture upload_texture;           //  ,     (bindless)
+        int first_level = 0;                //   
+        int upload_level = 0;               //   
+        int uploaded_rows = 0;              //       
+    };
+
+    /*
+     *      .
+     */
+    struct DecodedImage
+    {
+        int id;
+        int width;
+        int height;
+        std::vector<unsigned char> pixels;  //   
+        std::vector<MipLevel> levels;
+    };
+
+    static std::vector<TextureEntry> g_textures;
+    static std::deque<int> g_upload_queue;      // ,   
+
+    static std::mutex g_decoded_mutex;
+    static std::vector<DecodedImage> g_decoded;     //     
+
+    /*
+     * ,    (preload_texture()).
+     *  load_texture()  ,     ,
+     *       g_decoded.
+     */
+    struct PreloadedImage
+    {
+        bool done = false;                  //   
+        int id = -1;                        // ,   
+        bool resize = false;                //       
+        DecodedImage image = { -1, 0, 0, {}, {} };
+    };
+
+    static std::mutex g_preloaded_mutex;
+    static std::unordered_map<std::string, PreloadedImage> g_preloaded;    //  -> 
+
+    /*
+     *    (PBO),      CPU.
+     *     -    ,   fence ,
+     *      ,   GPU  .
+     */
+    constexpr int staging_segments = 3;
+    constexpr size_t staging_segment_size = 4 * 1024 * 1024;    // 4 MB  
+    constexpr size_t upload_budget = staging_segment_size;      //      
+
+    static GlBuffer g_staging_buffer;
+    static unsigned char* g_staging_memory = nullptr;
+    static std::array<GLsync, staging_segments> g_staging_fences = {};
+    static int g_staging_frame = 0;
+
+    static GlTexture g_placeholder;             // ,       
+    static bool g_has_s3tc = false;             //   BC1/BC3  
+    static int g_generation = 0;                //      
+
+    /*
+     *   GPU   .
+     *      ,    ,
+     *    -   ,  - (LRU).
+     * ,    ,  ,   .
+     */
+    constexpr size_t default_texture_budget = 256 * 1024 * 1024;
+    constexpr int min_resident_size = 32;       //        
+    constexpr int retry_delay = 60;             //        ,    
+
+    static size_t g_budget = default_texture_budget;
+    static size_t g_resident_bytes = 0;         //   (     )
+    static int g_evictions = 0;                 //  
+    static size_t g_evicted_bytes = 0;          //     
+    static int g_frame = 0;                     //     LRU
+
+    /*
+     * Bindless  -     ,    
+     *  64- handle    .
+     */
+    static bool g_bindless = false;
+    static uint64_t g_placeholder_handle = 0;
+
+    /*
+     *    bindless -       
+     *   .        .
+     *  0   .
+     */
+    constexpr int texture_array_size = 512;
+    constexpr int texture_array_levels = 10;    // log2(512) + 1
+
+    static GlTexture g_texture_array;
+    static int g_array_capacity = 0;    //  ,    
+    static int g_array_layers = 0;      //  ,  
+    static std::vector<int> g_free_layers;  //     
+
+    /*
+     *         capacity .
+     *     (  )    .
+     */
+    static void allocate_texture_array(int capacity)
+    {
+        GlTexture texture_array(GL_TEXTURE_2D_ARRAY, texture_array_levels, GL_RGBA8,
+            texture_array_size, texture_array_size, capacity);
+        texture_array.set_sampling(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, GL_CLAMP_TO_EDGE);
+
+        if (g_texture_array)
+        {
+            for (int level = 0; level < texture_array_levels; level++)
+            {
+                const int size = std::max(1, texture_array_size >> level);
+                glCopyImageSubData(g_texture_array.id(), GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+                    texture_array.id(), GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+                    size, size, g_array_layers);
+            }
+        }
+
+        g_texture_array = std::move(texture_array);     //    
+        g_array_capacity = capacity;
+    }
+
+    /*
+     *          .
+     */
+    static size_t array_layer_bytes(void)
+    {
+        size_t bytes = 0;
+        for (int level = 0; level < texture_array_levels; level++)
+        {
+            const size_t size = std::max(1, texture_array_size >> level);
+            bytes += size * size * 4;
+        }
+        return bytes;
+    }
+
+    /*
+     *     .     .
+     *   ,   ,       .
+     */
+    static int allocate_layer(void)
+    {
+        if (g_free_layers.empty() == false)
+        {
+            const int layer = g_free_layers.back();
+            g_free_layers.pop_back();
+            return layer;
+        }
+
+        if (g_array_layers == g_array_capacity)
+        {
+            const int max_layers = 1 + static_cast<int>(g_budget / array_layer_bytes());     // + 
+            allocate_texture_array(std::max(g_array_layers + 1, std::min(g_array_capacity * 2, max_layers)));
+            g_generation++;     //    
+        }
+
+        return g_array_layers++;
+    }
+
+    /*
+     *      (source_size ),     
+     *  size      .       
+     *  ,     (box ),   -  .
+     */
+    struct ResampleWeights
+    {
+        int first;                  //    
+        std::vector<float> weights; //      
+    };
+
+    static std::vector<ResampleWeights> resample_weights(int source_size, int size)
+    {
+        const float scale = static_cast<float>(source_size) / size;
+        std::vector<ResampleWeights> result(size);
+        for (int i = 0; i < size; i++)
+        {
+            ResampleWeights& entry = result[i];
+            if (scale > 1.0f)
+            {
+                const float start = i * scale;
+                const float end = std::min((i + 1) * scale, static_cast<float>(source_size));
+                entry.first = static_cast<int>(start);
+                const int last = std::min(static_cast<int>(std::ceil(end)), source_size);
+                for (int j = entry.first; j < last; j++)
+                    entry.weights.push_back((std::min(end, j + 1.0f) - std::max(start, static_cast<float>(j))) / (end - start));
+            }
+            else
+            {
+                const float source = std::clamp((i + 0.5f) * scale - 0.5f, 0.0f, source_size - 1.0f);
+                entry.first = static_cast<int>(source);
+                const float fraction = source - entry.first;
+                entry.weights.push_back(1.0f - fraction);
+                if (entry.first + 1 < source_size)
+                    entry.weights.push_back(fraction);
+            }
+        }
+        return result;
+    }
+
+    /*
+     *         .   
+     *       ,   - .
+     *    ,  .
+     */
+    static void resize_image(const unsigned char* pixels, int width, int height, int size, unsigned char* result)
+    {
+        const SrgbTables& tables = srgb_tables();
+        const std::vector<ResampleWeights> columns = resample_weights(width, size);
+        const std::vector<ResampleWeights> rows = resample_weights(height, size);
+
+        std::vector<float> horizontal(static_cast<size_t>(height) * size * 4, 0.0f);
+        for (int y = 0; y < height; y++)
+        {
+            const unsigned char* source_row = pixels + static_cast<size_t>(y) * width * 4;
+            float* out = &horizontal[static_cast<size_t>(y) * size * 4];
+            for (int x = 0; x < size; x++, out += 4)
+            {
+                const ResampleWeights& column = columns[x];
+                for (size_t i = 0; i < column.weights.size(); i++)
+                {
+                    const unsigned char* pixel = source_row + (column.first + i) * 4;
+                    const float weight = column.weights[i];
+                    out[0] += tables.to_linear[pixel[0]] * weight;
+                    out[1] += tables.to_linear[pixel[1]] * weight;
+                    out[2] += tables.to_linear[pixel[2]] * weight;
+                    out[3] += pixel[3] * (weight / 255.0f);
+                }
+            }
+        }
+
+        std::vector<float> sum(static_cast<size_t>(size) * 4);
+        for (int y = 0; y < size; y++)
+        {
+            std::fill(sum.begin(), sum.end(), 0.0f);
+            const ResampleWeights& row = rows[y];
+            for (size_t i = 0; i < row.weights.size(); i++)
+            {
+                const float* in = &horizontal[(row.first + i) * size * 4];
+                for (int c = 0; c < size * 4; c++)
+                    sum[c] += in[c] * row.weights[i];
+            }
+
+            unsigned char* out = result + static_cast<size_t>(y) * size * 4;
+            for (int x = 0; x < size; x++)
+            {
+                for (int c = 0; c < 3; c++)
+                    out[x * 4 + c] = linear_to_srgb(tables, sum[x * 4 + c]);
+                out[x * 4 + 3] = static_cast<unsigned char>(std::clamp(sum[x * 4 + 3], 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+    }
+
+    /*
+     *   -     .
+     */
+    void init_textures(void)
+    {
+        const unsigned char white[4] = { 255, 255, 255, 255 };
+
+        g_placeholder = GlTexture(GL_TEXTURE_2D, 1, GL_RGBA8, 1, 1);
+        glTextureSubImage2D(g_placeholder.id(), 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, white);
+
+        const size_t size = staging_segment_size * staging_segments;
+        const unsigned int flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        g_staging_buffer = GlBuffer(size, nullptr, flags);
+        g_staging_memory = static_cast<unsigned char*>(g_staging_buffer.map(0, size, flags));
+
+        g_has_s3tc = has_gl_extension("GL_EXT_texture_compression_s3tc");
+        g_bindless = glGetTextureHandleARB != nullptr &&
+            glMakeTextureHandleResidentARB != nullptr &&
+            glMakeTextureHandleNonResidentARB != nullptr;
+
+        if (g_bindless)
+        {
+            g_placeholder_handle = glGetTextureHandleARB(g_placeholder.id());
+            glMakeTextureHandleResidentARB(g_placeholder_handle);
+        }
+        else
+        {
+            allocate_texture_array(4);
+            for (int level = 0; level < texture_array_levels; level++)
+            {
+                const int size = std::max(1, texture_array_size >> level);
+                glClearTexSubImage(g_texture_array.id(), level, 0, 0, 0, size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE, white);
+            }
+            g_array_layers = 1;
+        }
+    }
+
+    /*
+     *         .cgtex .
+     *            -    
+     *   .    ,    
+     *  ,    .
+     */
+    static bool validate_compressed(std::span<const unsigned char> file)
+    {
+        if (file.size() < sizeof(CompressedTextureHeader))
+            return false;
+
+        const auto* header = reinterpret_cast<const CompressedTextureHeader*>(file.data());
+        if (std::memcmp(header->magic, compressed_texture_magic, sizeof(header->magic)) != 0 ||
+            header->version != compressed_texture_version ||
+            (header->format != COMPRESSED_BC1 && header->format != COMPRESSED_BC3) ||
+            header->width == 0 || header->height == 0 ||
+            header->width > max_compressed_texture_size || header->height > max_compressed_texture_size ||
+            header->levels == 0 || header->levels > static_cast<uint32_t>(std::bit_width(std::max(header->width, header->height))) ||
+            file.size() < sizeof(CompressedTextureHeader) + header->levels * sizeof(CompressedTextureLevel))
+            return false;
+
+        const auto* levels = reinterpret_cast<const CompressedTextureLevel*>(header + 1);
+        for (uint32_t i = 0; i < header->levels; i++)
+        {
+            const uint64_t blocks = uint64_t((levels[i].width + 3) / 4) * ((levels[i].height + 3) / 4);
+            if (levels[i].width != std::max(1u, header->width >> i) || levels[i].height != std::max(1u, header->height >> i) ||
+                levels[i].size != blocks * compressed_block_size(header->format) ||
+                levels[i].size > file.size() || levels[i].offset > file.size() - levels[i].size)
+                return false;
+        }
+
+        return true;
+    }
+
+    /*
+     *      .
+     *      (    )       0   
+     * (  - OpenGL ),      .
+     *     ,   glGenerateMipmap    -
+     *     ,      .
+     *  build_levels = false     0 (  ,    ).
+     */
+    static bool decode_texture(const std::string& path, bool resize, DecodedImage& image, bool build_levels = true)
+    {
+        Resource file;
+        if (open_resource(path, file) == false)
+            return false;
+
+        int width = 0;
+        int height = 0;
+        bool result = get_image_info(file.data.data(), file.data.size(), width, height);
+        if (result)
+        {
+            if (resize && (width != texture_array_size || height != texture_array_size))
+            {
+                std::vector<unsigned char> source(static_cast<size_t>(width) * height * 4);
+                result = decode_image(file.data.data(), file.data.size(), source.data(), static_cast<size_t>(width) * 4, true);
+
+                image.width = texture_array_size;
+                image.height = texture_array_size;
+                prepare_mip_chain(image.width, image.height, image.pixels, image.levels);
+                if (result)
+                    resize_image(source.data(), width, height, texture_array_size, image.pixels.data());
+            }
+            else
+            {
+                image.width = width;
+                image.height = height;
+                prepare_mip_chain(width, height, image.pixels, image.levels);
+                result = decode_image(file.data.data(), file.data.size(), image.pixels.data(), static_cast<size_t>(width) * 4, true);
+            }
+        }
+
+        close_resource(file);
+        if (result && build_levels)
+            build_mip_chain(image.pixels, image.levels);
+        return result;
+    }
+
+    /*
+     *           .
+     *       -      
+     *              .
+     *     ( .cgtex)  ,    .
+     */
+    static void finish_preloaded(const std::string& path, bool resize, DecodedImage& image)
+    {
+        if (image.pixels.empty())
+        {
+            if (decode_texture(path, resize, image) == false)
+                image.pixels.clear();
+        }
+        else if (resize && (image.width != texture_array_size || image.height != texture_array_size))
+        {
+            const std::vector<unsigned char> source = std::move(image.pixels);     //  0   
+            const int width = image.width;
+            const int height = image.height;
+
+            image.width = texture_array_size;
+            image.height = texture_array_size;
+            prepare_mip_chain(image.width, image.height, image.pixels, image.levels);
+            resize_image(source.data(), width, height, texture_array_size, image.pixels.data());
+            build_mip_chain(image.pixels, image.levels);
+        }
+        else
+        {
+            build_mip_chain(image.pixels, image.levels);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(g_decoded_mutex);
+            g_decoded.push_back(std::move(image));
+        }
+        request_redraw();   //    update_textures()
+    }
+
+    /*
+     *      0      
+     *  OpenGL  (    ). load_texture()   
+     *  ,    -    .
+     *     .cgtex ,    -  
+     *  BC     .
+     *           ,
+     *       -  load_texture().
+     */
+    void preload_texture(const std::string& path)
+    {
+        if (std::thread::hardware_concurrency() <= 1)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(g_preloaded_mutex);
+            g_preloaded[path] = PreloadedImage();
+        }
+
+        submit_task([path]
+        {
+            DecodedImage image = { -1, 0, 0, {}, {} };
+
+            Resource file;
+            const std::string compressed_path = std::filesystem::path(path).replace_extension(".cgtex").string();
+            const bool has_compressed = open_resource(compressed_path, file) && validate_compressed(file.data);
+            close_resource(file);
+
+            if (has_compressed == false && decode_texture(path, false, image, false) == false)
+                image.pixels.clear();
+
+            std::unique_lock<std::mutex> lock(g_preloaded_mutex);
+            auto preloaded = g_preloaded.find(path);
+            if (preloaded == g_preloaded.end())
+                return;
+
+            if (preloaded->second.id < 0)
+            {
+                preloaded->second.image = std::move(image);     //    
+                preloaded->second.done = true;
+                return;
+            }
+
+            image.id = preloaded->second.id;
+            const bool resize = preloaded->second.resize;
+            g_preloaded.erase(preloaded);
+            lock.unlock();
+
+            finish_preloaded(path, resize, image);
+        });
+    }
+
+    /*
+     *     .
+     */
+    static int level_size(int size, int level)
+    {
+        return std::max(1, size >> level);
+    }
+
+    /*
+     *      .
+     */
+    static size_t level_bytes(const TextureEntry& entry, int level)
+    {
+        const size_t width = level_size(entry.width, level);
+        const size_t height = level_size(entry.height, level);
+        if (entry.internal_format == GL_RGBA8)
+            return width * height * 4;
+
+        const uint32_t format = entry.internal_format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? COMPRESSED_BC1 : COMPRESSED_BC3;
+        return ((width + 3) / 4) * ((height + 3) / 4) * compressed_block_size(format);
+    }
+
+    /*
+     *     first_level    .
+     */
+    static size_t texture_bytes(const TextureEntry& entry, int first_level)
+    {
+        size_t bytes = 0;
+        for (int level = first_level; level < entry.level_count; level++)
+            bytes += level_bytes(entry, level);
+        return bytes;
+    }
+
+    /*
+     *  ,    -  min_resident_size.
+     *   -     ,     .
+     */
+    static int tail_level(const TextureEntry& entry)
+    {
+        int level = 0;
+        while (level + 1 < entry.level_count &&
+            std::max(level_size(entry.width, level), level_size(entry.height, level)) > min_resident_size)
+            level++;
+        return level;
+    }
+
+    /*
+     * - ,        .
+     *         0,   -  1  ..
+     */
+    static int sampled_level(const TextureEntry& entry)
+    {
+        const float texels = static_cast<float>(std::max(entry.width, entry.height));
+        const float ratio = texels / std::max(entry.screen_size, 1.0f);
+        const int level = ratio > 1.0f ? static_cast<int>(std::floor(std::log2(ratio))) : 0;
+        return std::clamp(level, 0, tail_level(entry));
+    }
+
+    /*
+     *       .
+     */
+    static bool is_in_use(const TextureEntry& entry)
+    {
+        return entry.last_used >= 0 && g_frame - entry.last_used <= 1;
+    }
+
+    /*
+     *          .
+     */
+    static GlTexture create_texture(unsigned int internal_format, int width, int height, int levels)
+    {
+        GlTexture texture(GL_TEXTURE_2D, levels, internal_format, width, height);
+        texture.set_sampling(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, GL_CLAMP_TO_EDGE);
+        return texture;
+    }
+
+    /*
+     *     first_level         GPU .
+     * source_base  destination_base    ,      .
+     */
+    static void copy_levels(const TextureEntry& entry,
+        unsigned int source,
+        int source_base,
+        unsigned int destination,
+        int destination_base,
+        int first_level)
+    {
+        for (int level = first_level; level < entry.level_count; level++)
+        {
+            glCopyImageSubData(source, GL_TEXTURE_2D, level - source_base, 0, 0, 0,
+                destination, GL_TEXTURE_2D, level - destination_base, 0, 0, 0,
+                level_size(entry.width, level), level_size(entry.height, level), 1);
+        }
+    }
+
+    /*
+     *   ,      .
+     */
+    static void release_texture(TextureEntry& entry)
+    {
+        if (entry.handle != 0)
+            glMakeTextureHandleNonResidentARB(entry.handle);
+        entry.texture.reset();
+
+        g_resident_bytes -= entry.resident_bytes;
+        entry.handle = 0;
+        entry.resident_bytes = 0;
+    }
+
+    /*
+     *   ,    .
+     * Bindless handle    ,           .
+     */
+    static void set_texture(TextureEntry& entry, GlTexture texture, int base_level)
+    {
+        entry.texture = std::move(texture);
+        entry.base_level = base_level;
+        entry.resident_bytes = texture_bytes(entry, base_level);
+        entry.handle = glGetTextureHandleARB(entry.texture.id());
+        glMakeTextureHandleResidentARB(entry.handle);
+        g_generation++;
+    }
+
+    /*
+     *     base_level (bindless).
+     *      - ,      GPU .
+     */
+    static void evict_levels(TextureEntry& entry, int base_level)
+    {
+        GlTexture texture = create_texture(entry.internal_format,
+            level_size(entry.width, base_level),
+            level_size(entry.height, base_level),
+            entry.level_count - base_level);
+        copy_levels(entry, entry.texture.id(), entry.base_level, texture.id(), base_level, base_level);
+
+        const size_t old_bytes = entry.resident_bytes;
+        release_texture(entry);
+        set_texture(entry, std::move(texture), base_level);
+
+        g_resident_bytes += entry.resident_bytes;
+        g_evicted_bytes += old_bytes - entry.resident_bytes;
+        g_evictions++;
+    }
+
+    /*
+     *       .
+     *    ,     .
+     */
+    static void evict_layer(TextureEntry& entry)
+    {
+        g_free_layers.push_back(entry.layer);
+        g_resident_bytes -= entry.resident_bytes;
+        g_evicted_bytes += entry.resident_bytes;
+        g_evictions++;
+
+        entry.layer = -1;
+        entry.resident_bytes = 0;
+        entry.ready = false;
+        g_generation++;
+    }
+
+    /*
+     *   ,  bytes     .
+     *   :
+     *   1. , -        (   ).
+     *   2.  ( )  ,        -  LRU.
+     *  false,        .
+     */
+    static bool reserve_memory(size_t bytes)
+    {
+        while (g_resident_bytes + bytes > g_budget)
+        {
+            int victim = -1;
+            bool victim_unsampled = false;
+
+            for (int id = 0; id < static_cast<int>(g_textures.size()); id++)
+            {
+                const TextureEntry& entry = g_textures[id];
+                if (entry.ready == false || entry.loading)
+                    continue;
+
+                bool unsampled = false;
+                if (g_bindless)
+                {
+                    if (entry.base_level >= tail_level(entry))
+                        continue;
+                    unsampled = entry.base_level + 1 < entry.wanted_level;
+                }
+                if (unsampled == false && is_in_use(entry))
+                    continue;
+
+                if (victim < 0 ||
+                    (unsampled && victim_unsampled == false) ||
+                    (unsampled == victim_unsampled && entry.last_used < g_textures[victim].last_used))
+                {
+                    victim = id;
+                    victim_unsampled = unsampled;
+                }
+            }
+
+            if (victim < 0)
+                return false;
+
+            TextureEntry& entry = g_textures[victim];
+            if (g_bindless)
+                evict_levels(entry, victim_unsampled ? entry.wanted_level - 1 : entry.base_level + 1);
+            else
+                evict_layer(entry);
+        }
+
+        return true;
+    }
+
+    /*
+     *     .
+     *       .cgtex  (tools/texconv)
+     *    bindless,      (    )    
+     * ,  .     RGBA8    BC .
+     *      ,   -   update_textures().
+     */
+    static void start_loading(int id)
+    {
+        TextureEntry& entry = g_textures[id];
+        entry.loading = true;
+
+        if (g_has_s3tc && g_bindless)
+        {
+            const std::string compressed_path = std::filesystem::path(entry.path).replace_extension(".cgtex").string();
+
+            Resource file;
+            if (open_resource(compressed_path, file))
+            {
+                if (validate_compressed(file.data))
+                {
+                    const auto* header = reinterpret_cast<const CompressedTextureHeader*>(file.data.data());
+                    entry.compressed = file;
+                    entry.width = static_cast<int>(header->width);
+                    entry.height = static_cast<int>(header->height);
+                    entry.level_count = static_cast<int>(header->levels);
+                    entry.internal_format = header->format == COMPRESSED_BC1 ?
+                        GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                    entry.first_level = std::min(entry.wanted_level, tail_level(entry));
+                    entry.upload_level = entry.first_level;
+                    g_upload_queue.push_back(id);
+                    return;
+                }
+
+                std::cerr << "Invalid compressed texture " << compressed_path << "." << std::endl;
+                close_resource(file);
+            }
+        }
+
+        const std::string path = entry.path;
+        const bool resize = g_bindless == false;
+
+        // ,     
+        {
+            std::lock_guard<std::mutex> lock(g_preloaded_mutex);
+            auto preloaded = g_preloaded.find(path);
+            if (preloaded != g_preloaded.end())
+            {
+                if (preloaded->second.done == false)
+                {
+                    preloaded->second.id = id;      //     
+                    preloaded->second.resize = resize;
+                    return;
+                }
+
+                auto image = std::make_shared<DecodedImage>(std::move(preloaded->second.image));
+                g_preloaded.erase(preloaded);
+
+                image->id = id;
+                submit_task([path, resize, image] { finish_preloaded(path, resize, *image); });
+                return;
+            }
+        }
+
+        submit_task([id, path, resize]
+        {
+            DecodedImage image = { id, 0, 0, {}, {} };
+            if (decode_texture(path, resize, image) == false)
+                image.pixels.clear();
+
+            {
+                std::lock_guard<std::mutex> lock(g_decoded_mutex);
+                g_decoded.push_back(std::move(image));
+            }
+            request_redraw();
+        });
+    }
+
+    /*
+     *   ,       .
+     *     retry_delay .
+     */
+    static void cancel_loading(TextureEntry& entry)
+    {
+        if (entry.compressed.data.empty() == false)
+            close_resource(entry.compressed);
+        entry.pixels = std::vector<unsigned char>();
+        entry.levels.clear();
+        entry.loading = false;
+        entry.retry_frame = g_frame + retry_delay;
+        g_upload_queue.pop_front();
+    }
+
+    /*
+     *     .
+     *    get_texture_handle()  get_texture_layer().
+     */
+    int load_texture(const std::string& path)
+    {
+        TextureEntry entry;
+        entry.path = path;
+        g_textures.push_back(std::move(entry));
+        int id = static_cast<int>(g_textures.size()) - 1;
+
+        start_loading(id);
+        return id;
+    }
+
+    /*
+     * ,             ( ).
+     *  -        - ,   .
+     */
+    void mark_texture_used(int id, float screen_size)
+    {
+        if (id < 0 || id >= static_cast<int>(g_textures.size()))
+            return;
+
+        TextureEntry& entry = g_textures[id];
+        if (entry.last_used != g_frame)
+        {
+            entry.last_used = g_frame;
+            entry.screen_size = 0.0f;
+        }
+        entry.screen_size = std::max(entry.screen_size, screen_size);
+    }
+
+    /*
+     *     GPU     .
+     */
+    void set_texture_budget(size_t bytes)
+    {
+        g_budget = bytes;
+    }
+
+    /*
+     *     .
+     */
+    TextureStats get_texture_stats(void)
+    {
+        TextureStats stats = { g_resident_bytes, g_budget, 0, g_evictions, g_evicted_bytes };
+        for (const TextureEntry& entry : g_textures)
+        {
+            if (entry.ready)
+                stats.resident_textures++;
+        }
+        return stats;
+    }
+
+    /*
+     * Bindless handle     ,     .
+     */
+    uint64_t get_texture_handle(int id)
+    {
+        if (is_texture_ready(id) == false)
+            return g_placeholder_handle;
+        return g_textures[id].handle;
+    }
+
+    /*
+     *       0 (),     .
+     */
+    unsigned int get_texture_layer(int id)
+    {
+        if (is_texture_ready(id) == false)
+            return 0;
+        return static_cast<unsigned int>(g_textures[id].layer);
+    }
+
+    /*
+     *    (0,    bindless ).
+     */
+    unsigned int get_texture_array(void)
+    {
+        return g_texture_array.id();
+    }
+
+    /*
+     *      bindless handle.
+     */
+    bool has_bindless_textures(void)
+    {
+        return g_bindless;
+    }
+
+    /*
+     * ,   ,  handle       .
+     */
+    int get_textures_generation(void)
+    {
+        return g_generation;
+    }
+
+    /*
+     *       .
+     */
+    bool is_texture_ready(int id)
+    {
+        if (id < 0 || id >= static_cast<int>(g_textures.size()))
+            return false;
+        return g_textures[id].ready;
+    }
+
+    /*
+     *         (  ).
+     */
+    bool is_texture_failed(int id)
+    {
+        if (id < 0 || id >= static_cast<int>(g_textures.size()))
+            return true;
+        return g_textures[id].failed;
+    }
+
+    /*
+     *   .
+     *  bindless     ,    
+     *  CPU   .
+     */
+    static void finish_texture(TextureEntry& entry)
+    {
+        if (g_bindless)
+        {
+            GlTexture texture = std::move(entry.upload_texture);
+            release_texture(entry);
+            set_texture(entry, std::move(texture), entry.first_level);
+        }
+        else
+        {
+            g_generation++;
+        }
+
+        if (entry.compressed.data.empty() == false)
+            close_resource(entry.compressed);
+        entry.pixels = std::vector<unsigned char>();
+        entry.levels.clear();
+        entry.ready = true;
+        entry.loading = false;
+        g_upload_queue.pop_front();
+    }
+
+    /*
+     *     GPU      .
+     *  bindless ,       ,   - .
+     *   -       ,    .
+     *  bindless      .
+     *   ,         retry_delay  -
+     *    ,       .
+     *  false,    .
+     */
+    static bool begin_upload(TextureEntry& entry)
+    {
+        if (g_bindless == false)
+        {
+            if (reserve_memory(array_layer_bytes()) == false)
+            {
+                cancel_loading(entry);
+                return false;
+            }
+
+            entry.layer = allocate_layer();
+            entry.resident_bytes = array_layer_bytes();
+            g_resident_bytes += entry.resident_bytes;
+            return true;
+        }
+
+        const int last_level = entry.texture.id() != 0 ? entry.base_level - 1 : tail_level(entry);
+        while (entry.first_level < last_level && reserve_memory(texture_bytes(entry, entry.first_level)) == false)
+            entry.first_level++;
+
+        if (entry.first_level > last_level ||
+            (entry.texture.id() != 0 && reserve_memory(texture_bytes(entry, entry.first_level)) == false))
+        {
+            cancel_loading(entry);
+            return false;
+        }
+
+        entry.upload_level = entry.first_level;
+        entry.upload_texture = create_texture(entry.internal_format,
+            level_size(entry.width, entry.first_level),
+            level_size(entry.height, entry.first_level),
+            entry.level_count - entry.first_level);
+        g_resident_bytes += texture_bytes(entry, entry.first_level);
+        return true;
+    }
+
+    /*
+     *              .
+     *  false,          .
+     */
+    static bool upload_compressed_level(TextureEntry& entry, size_t& used)
+    {
+        const auto* header = reinterpret_cast<const CompressedTextureHeader*>(entry.compressed.data.data());
+        const auto* levels = reinterpret_cast<const CompressedTextureLevel*>(header + 1);
+        const CompressedTextureLevel& level = levels[entry.upload_level];
+
+        if (used > 0 && used + level.size > upload_budget)
+            return false;
+
+        glCompressedTextureSubImage2D(entry.upload_texture.id(),
+            entry.upload_level - entry.first_level,
+            0,
+            0,
+            level.width,
+            level.height,
+            entry.internal_format,
+            static_cast<int>(level.size),
+            entry.compressed.data.data() + level.offset);
+
+        used += level.size;
+        entry.upload_level++;
+
+        if (entry.upload_level == entry.level_count)
+            finish_texture(entry);
+
+        return true;
+    }
+
+    /*
+     *           .
+     */
+    static void collect_decoded(void)
+    {
+        std::vector<DecodedImage> decoded;
+        {
+            std::lock_guard<std::mutex> lock(g_decoded_mutex);
+            decoded.swap(g_decoded);
+        }
+
+        for (DecodedImage& image : decoded)
+        {
+            TextureEntry& entry = g_textures[image.id];
+            if (image.pixels.empty())
+            {
+                std::cerr << "Failed to load texture " << entry.path << "." << std::endl;
+                entry.loading = false;
+                entry.failed = true;
+                continue;
+            }
+
+            entry.width = image.width;
+            entry.height = image.height;
+            entry.level_count = static_cast<int>(image.levels.size());
+            entry.internal_format = GL_RGBA8;
+            entry.pixels = std::move(image.pixels);
+            entry.levels = std::move(image.levels);
+            if (is_in_use(entry))
+                entry.wanted_level = sampled_level(entry);
+            entry.first_level = g_bindless ? std::min(entry.wanted_level, tail_level(entry)) : 0;
+            entry.upload_level = entry.first_level;
+            g_upload_queue.push_back(image.id);
+        }
+    }
+
+    /*
+     *         .
+     * ,    -    ,     .
+     *       (   ).
+     */
+    static void update_residency(void)
+    {
+        for (int id = 0; id < static_cast<int>(g_textures.size()); id++)
+        {
+            TextureEntry& entry = g_textures[id];
+            if (entry.failed || entry.loading)
+                continue;
+
+            if (entry.last_used == g_frame && entry.level_count > 0)
+                entry.wanted_level = sampled_level(entry);
+            if (is_in_use(entry) == false || g_frame < entry.retry_frame)
+                continue;
+
+            if (g_bindless ? entry.wanted_level < entry.base_level : entry.ready == false)
+                start_loading(id);
+        }
+
+        reserve_memory(0);
+    }
+
+    /*
+     *          
+     *   PBO      ,      .
+     *          .
+     *          ,  PBO.
+     * ,      ,      GPU .
+     */
+    static void upload_textures(void)
+    {
+        if (g_upload_queue.empty() || g_staging_memory == nullptr)
+            return;
+
+        /*
+         *   ,  GPU      staging_segments .
+         *    -       .
+         */
+        const int segment = g_staging_frame % staging_segments;
+        GLsync& fence = g_staging_fences[segment];
+        if (fence != nullptr)
+        {
+            if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+                return;
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        const size_t segment_offset = segment * staging_segment_size;
+        size_t used = 0;        //    
+        size_t staged = 0;      //   -   PBO 
+
+        while (g_upload_queue.empty() == false)
+        {
+            TextureEntry& entry = g_textures[g_upload_queue.front()];
+            if (g_bindless ? entry.upload_texture.id() == 0 : entry.layer < 0)
+            {
+                if (begin_upload(entry) == false)
+                    continue;       //  -     
+            }
+
+            if (g_bindless && entry.texture.id() != 0 && entry.upload_level >= entry.base_level)
+            {
+                copy_levels(entry, entry.texture.id(), entry.base_level,
+                    entry.upload_texture.id(), entry.first_level, entry.upload_level);
+                finish_texture(entry);
+                continue;
+            }
+
+            if (entry.compressed.data.empty() == false)
+            {
+                if (upload_compressed_level(entry, used) == false)
+                    break;
+                continue;
+            }
+
+            const int level_index = entry.upload_level;
+            const MipLevel& level = entry.levels[level_index];
+            const size_t row_size = static_cast<size_t>(level.width) * 4;
+            const int rows_left = level.height - entry.uploaded_rows;
+
+            int rows = static_cast<int>(std::min<size_t>(rows_left, (upload_budget - used) / row_size));
+            if (rows == 0 && used == 0 && row_size <= staging_segment_size)
+                rows = 1;   // , -  ,      
+            if (rows == 0)
+                break;
+
+            const size_t size = rows * row_size;
+            std::memcpy(g_staging_memory + segment_offset + staged,
+                entry.pixels.data() + level.offset + entry.uploaded_rows * row_size,
+                size);
+
+            bind_buffer(GL_PIXEL_UNPACK_BUFFER, g_staging_buffer.id());
+            if (g_bindless)
+            {
+                glTextureSubImage2D(entry.upload_texture.id(),  //   PBO -      
+                    level_index - entry.first_level,
+                    0,
+                    entry.uploaded_rows,
+                    level.width,
+                    rows,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    reinterpret_cast<const void*>(segment_offset + staged));
+            }
+            else
+            {
+                glTextureSubImage3D(g_texture_array.id(),
+                    level_index,
+                    0,
+                    entry.uploaded_rows,
+                    entry.layer,
+                    level.width,
+                    rows,
+                    1,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    reinterpret_cast<const void*>(segment_offset + staged));
+            }
+            bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            used += size;
+            staged += size;
+            entry.uploaded_rows += rows;
+
+            if (entry.uploaded_rows == level.height)
+            {
+                entry.uploaded_rows = 0;
+                entry.upload_level++;
+            }
+
+            if (entry.upload_level == entry.level_count)
+                finish_texture(entry);
+        }
+
+        if (staged > 0)
+        {
+            fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            g_staging_frame++;
+        }
+    }
+
+    /*
+     *          ,  .
+     *   .      (new_frame),   
+     *           LRU -   
+     * (    )       .
+     */
+    void update_textures(bool new_frame)
+    {
+        collect_decoded();
+        if (new_frame)
+            update_residency();
+        upload_textures();
+        if (new_frame)
+            g_frame++;
+
+        if (g_upload_queue.empty() == false)
+            request_redraw();   //     
+    }
+
+    /*
+     *       .
+     *        ,      .
+     */
+    void cleanup_textures(void)
+    {
+        collect_decoded();
+        for (TextureEntry& entry : g_textures)
+        {
+            if (entry.compressed.data.empty() == false)
+                close_resource(entry.compressed);
+            entry.upload_texture.reset();
+            release_texture(entry);
+        }
+        g_textures.clear();
+        g_upload_queue.clear();
+        g_preloaded.clear();
+        g_free_layers.clear();
+        g_resident_bytes = 0;
+
+        for (GLsync& fence : g_staging_fences)
+        {
+            if (fence != nullptr)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        g_staging_buffer.reset();    //      
+        if (g_placeholder_handle != 0)
+            glMakeTextureHandleNonResidentARB(g_placeholder_handle);
+        g_placeholder.reset();
+        g_texture_array.reset();
+
+        g_staging_memory = nullptr;
+        g_placeholder_handle = 0;
+        g_array_capacity = 0;
+        g_array_layers = 0;
+    }
+
+} // namespace cg
@@ -0,0 +1,41 @@
+#ifndef CG_TEXTURE
+#define CG_TEXTURE
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cg
+{
+
+/*
+ *      ( set_texture_budget()).
+ */
+struct TextureStats
+{
+    size_t resident_bytes;      //  GPU 
+    size_t budget;              //   GPU 
+    int resident_textures;      //  ,     
+    int evictions;              //      
+    size_t evicted_bytes;       //     
+};
+
+void init_textures(void);
+void preload_texture(const std::string& path);
+int load_texture(const std::string& path);
+bool is_texture_ready(int id);
+bool is_texture_failed(int id);
+uint64_t get_texture_handle(int id);
+unsigned int get_texture_layer(int id);
+unsigned int get_texture_array(void);
+bool has_bindless_textures(void);
+int get_textures_generation(void);
+void mark_texture_used(int id, float screen_size);
+void update_textures(bool new_frame);
+void set_texture_budget(size_t bytes);
+TextureStats get_texture_stats(void);
+void cleanup_textures(void);
+
+} // namespace cg
+
+#endif
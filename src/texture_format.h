@@ -0,0 +1,65 @@
+#ifndef CG_TEXTURE_FORMAT
+#define CG_TEXTURE_FORMAT
+
+#include <cstdint>
+
+/*
+ *     (.cgtex).
+ *      tools/texconv     
+ *    ,        GPU.
+ *
+ * :
+ *   CompressedTextureHeader
+ *   CompressedTextureLevel[levels]   -  -  - 
+ *     ,    compressed_texture_alignment 
+ */
+namespace cg
+{
+
+constexpr char compressed_texture_magic[4] = { 'C', 'G', 'T', 'X' };
+constexpr uint32_t compressed_texture_version = 1;
+constexpr uint32_t compressed_texture_alignment = 16;
+constexpr uint32_t max_compressed_texture_size = 16384;    // - /   0
+
+/*
+ *    (4x4   ).
+ */
+enum CompressedTextureFormat : uint32_t
+{
+    COMPRESSED_BC1 = 1,     // RGB, 8    (0.5   )
+    COMPRESSED_BC3 = 3,     // RGBA, 16    (1   )
+};
+
+struct CompressedTextureHeader
+{
+    char magic[4];          // "CGTX"
+    uint32_t version;       // compressed_texture_version
+    uint32_t format;        // CompressedTextureFormat
+    uint32_t width;         //    0
+    uint32_t height;        //    0
+    uint32_t levels;        //   
+    uint32_t reserved[2];
+};
+
+struct CompressedTextureLevel
+{
+    uint64_t offset;        //     
+    uint64_t size;          //    
+    uint32_t width;         //     
+    uint32_t height;        //     
+};
+
+static_assert(sizeof(CompressedTextureHeader) == 32, "Unexpected header size");
+static_assert(sizeof(CompressedTextureLevel) == 24, "Unexpected level size");
+
+/*
+ *      .
+ */
+constexpr uint32_t compressed_block_size(uint32_t format)
+{
+    return format == COMPRESSED_BC1 ? 8 : 16;
+}
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,157 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cg
+{
+    static std::vector<std::thread> g_workers;              //  
+    static std::deque<std::function<void()>> g_tasks;       // ,    
+    static std::mutex g_tasks_mutex;
+    static std::condition_variable g_tasks_condition;
+    static bool g_stopping = false;
+
+    /*
+     *    .
+     *    ,     .
+     */
+    static void worker_loop(void)
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(g_tasks_mutex);
+                g_tasks_condition.wait(lock, [] { return g_stopping || g_tasks.empty() == false; });
+                if (g_stopping && g_tasks.empty())
+                    return;
+
+                task = std::move(g_tasks.front());
+                g_tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+    /*
+     *    .
+     *      ,       (GL) .
+     */
+    void init_thread_pool(unsigned int thread_count)
+    {
+        if (g_workers.empty() == false)
+            return;
+
+        if (thread_count == 0)
+        {
+            const unsigned int cores = std::thread::hardware_concurrency();    // 0,    
+            thread_count = cores > 1 ? cores - 1 : 1;
+        }
+
+        g_stopping = false;
+        for (unsigned int i = 0; i < thread_count; i++)
+            g_workers.emplace_back(worker_loop);
+    }
+
+    /*
+     *     .
+     *      OpenGL -      .
+     */
+    void submit_task(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_tasks_mutex);
+            g_tasks.push_back(std::move(task));
+        }
+        g_tasks_condition.notify_one();
+    }
+
+    /*
+     *     parallel_for .
+     *    shared_ptr,      
+     *       .
+     */
+    struct ParallelFor
+    {
+        std::function<void(int)> function;
+        int count = 0;
+        std::atomic<int> next = 0;      //    
+        std::atomic<int> done = 0;      //   
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    /*
+     *   ,   .
+     */
+    static void run_parallel_for(ParallelFor& state)
+    {
+        int index;
+        while ((index = state.next++) < state.count)
+        {
+            state.function(index);
+            if (++state.done == state.count)
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.condition.notify_all();
+            }
+        }
+    }
+
+    /*
+     *   function(0) ... function(count - 1) .
+     *     ,       
+     *    ,     .
+     */
+    void parallel_for(int count, const std::function<void(int)>& function)
+    {
+        if (count <= 0)
+            return;
+
+        auto state = std::make_shared<ParallelFor>();
+        state->function = function;
+        state->count = count;
+
+        const int helpers = std::min(count - 1, static_cast<int>(g_workers.size()));
+        for (int i = 0; i < helpers; i++)
+            submit_task([state] { run_parallel_for(*state); });
+
+        run_parallel_for(*state);
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->condition.wait(lock, [&state] { return state->done == state->count; });
+    }
+
+    /*
+     *    .
+     */
+    unsigned int get_thread_count(void)
+    {
+        return static_cast<unsigned int>(g_workers.size());
+    }
+
+    /*
+     *   .
+     *      .
+     */
+    void cleanup_thread_pool(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_tasks_mutex);
+            g_stopping = true;
+        }
+        g_tasks_condition.notify_all();
+
+        for (std::thread& worker : g_workers)
+            worker.join();
+        g_workers.clear();
+    }
+
+} // namespace cg
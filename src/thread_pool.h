@@ -0,0 +1,17 @@
+#ifndef CG_THREAD_POOL
+#define CG_THREAD_POOL
+
+#include <functional>
+
+namespace cg
+{
+
+void init_thread_pool(unsigned int thread_count = 0);
+void submit_task(std::function<void()> task);
+void parallel_for(int count, const std::function<void(int)>& function);
+unsigned int get_thread_count(void);
+void cleanup_thread_pool(void);
+
+} // namespace cg
+
+#endif
@@ -3,6 +3,11 @@
 #include "backends/imgui_impl_opengl3.h"
 #include "ui.h"
 #include "structs.h"
+#include "gl_state.h"
+#include "lighting.h"
+#include "scene_target.h"
+#include "stream_buffer.h"
+#include "texture.h"
 
 //   extern         
 //      main     ,    
@@ -84,6 +89,8 @@ namespace cg
         ImGui::SliderFloat("Move Speed", &g_move_speed, 0.01f, 1.0f);           //     
         ImGui::SliderFloat("Rotation Speed", &g_rotation_speed, 0.5f, 10.0f);   //     
         ImGui::SliderFloat("Walk Speed", &cg::robot.walk_speed, 0.5f, 5.0f);    //     
+        ImGui::Checkbox("Walking", &cg::robot.walking);                         //   
+        ImGui::Checkbox("Redraw On Demand", &cg::redraw.on_demand);             //    
 
 		//     
         ImGui::Separator();
@@ -120,6 +127,63 @@ namespace cg
         ImGui::SliderFloat("Head Bob", &cg::robot.head_bob, 0.0f, 10.0f);             //     
         ImGui::SliderFloat("Antenna Wiggle", &cg::robot.antenna_wiggle, 0.0f, 20.0f); //     
 
+        //     
+        ImGui::Separator();
+        ImGui::Text("Crowd Controls:");
+        ImGui::SliderInt("Crowd Size", &cg::crowd.count, 0, 2000);              //   
+        ImGui::SliderInt("Teams", &cg::crowd.teams, 1, 4);                      //     
+        ImGui::SliderFloat("Crowd Spacing", &cg::crowd.spacing, 1.0f, 5.0f);    //   
+
+        //  
+        ImGui::Separator();
+        ImGui::Text("Lights:");
+        ImGui::Checkbox("Robot Lights", &cg::lighting.robot_lights);               //     
+        ImGui::SliderFloat("Light Radius", &cg::lighting.radius, 0.1f, 5.0f);       //   
+        ImGui::SliderFloat("Light Intensity", &cg::lighting.intensity, 0.0f, 4.0f); //   
+        ImGui::Text("Point lights: %d", cg::get_light_count());
+
+        //    
+        ImGui::Separator();
+        ImGui::Text("Resolution:");
+        ImGui::Checkbox("Dynamic Resolution", &cg::resolution.dynamic);             //   
+        ImGui::SliderFloat("Min Scale", &cg::resolution.min_scale, 0.25f, 1.0f);    // - 
+        ImGui::SliderFloat("Max Scale", &cg::resolution.max_scale, 0.25f, 1.0f);    // - 
+        ImGui::SliderFloat("GPU Budget (ms)", &cg::resolution.target_ms, 2.0f, 50.0f);  //    
+        ImGui::SliderFloat("Sharpness", &cg::resolution.sharpness, 0.0f, 1.0f);     //   
+        ImGui::Combo("Anti-Aliasing", &cg::resolution.anti_aliasing, "Off\0MSAA 2x\0MSAA 4x\0MSAA 8x\0FXAA\0");
+        if (cg::is_anti_aliasing_benchmark_running())
+            ImGui::Text("Benchmarking anti-aliasing...");
+        else if (ImGui::Button("Benchmark Anti-Aliasing"))                          //    
+            cg::start_anti_aliasing_benchmark();
+        const cg::SceneTargetStats scene_stats = cg::get_scene_target_stats();
+        ImGui::Text("Scene: %dx%d (%.0f%%), GPU %.2f ms",
+            scene_stats.width, scene_stats.height, scene_stats.scale * 100.0f, scene_stats.gpu_ms);
+
+        //      
+        const cg::StreamBufferStats stream_stats = cg::get_stream_buffer_stats();
+        ImGui::Text("Frame data: %zu / %zu KB, GPU waits: %d",
+            stream_stats.used / 1024, stream_stats.region_size / 1024, stream_stats.waits);
+
+        //   OpenGL  (    Debug)
+        if (cg::has_gl_state_stats())
+        {
+            ImGui::Separator();
+            const cg::GlStateStats gl_stats = cg::get_gl_state_stats();
+            ImGui::Text("GL state calls: %d, skipped: %d", gl_stats.calls, gl_stats.skipped);
+        }
+
+        //   
+        ImGui::Separator();
+        ImGui::Text("Textures:");
+        const cg::TextureStats texture_stats = cg::get_texture_stats();
+        int budget_mb = static_cast<int>(texture_stats.budget / (1024 * 1024));
+        if (ImGui::SliderInt("Texture Budget (MB)", &budget_mb, 1, 1024))     //   GPU 
+            cg::set_texture_budget(static_cast<size_t>(budget_mb) * 1024 * 1024);
+        ImGui::Text("Resident: %.2f MB in %d textures",
+            texture_stats.resident_bytes / (1024.0 * 1024.0), texture_stats.resident_textures);
+        ImGui::Text("Evictions: %d (%.2f MB)",
+            texture_stats.evictions, texture_stats.evicted_bytes / (1024.0 * 1024.0));
+
         //        
         if (ImGui::Button("Reset Robot")) {
             //     
@@ -178,6 +242,15 @@ namespace cg
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     }
 
+    /*
+     *         (  ,   ).
+     *    render_ImGui().
+     */
+    bool is_ImGui_active(void)
+    {
+        return ImGui::IsAnyItemActive() || ImGui::GetIO().WantTextInput;
+    }
+
     /*
      *   ImGui .
      *        .
@@ -9,6 +9,7 @@ namespace cg
 void init_ImGui(GLFWwindow* window);
 void render_ImGui(void);
 void display_ImGui(void);
+bool is_ImGui_active(void);
 void cleanup_ImGui(void);
 
 } // namespace cg
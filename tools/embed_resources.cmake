@@ -0,0 +1,53 @@
+# Generates a C++ source with the shaders and default textures as constexpr byte arrays.
+# Usage: cmake -DROOT=<repository root> -DOUTPUT=<file.cpp> -P embed_resources.cmake
+#
+# The table is sorted by name ("resources/shaders/tex_v.glsl", ...) so the runtime can
+# binary search it (src/embedded.cpp). Every array gets a trailing zero byte that is not
+# counted in the size, so empty files are valid and text can be read as a C string.
+
+file(GLOB embeddedFiles RELATIVE ${ROOT}
+    ${ROOT}/resources/shaders/*.glsl
+    ${ROOT}/resources/textures/*.png
+)
+list(SORT embeddedFiles)
+
+set(arrays "")
+set(table "")
+set(index 0)
+foreach(name ${embeddedFiles})
+    file(READ ${ROOT}/${name} bytes HEX)
+    string(LENGTH "${bytes}" length)
+    math(EXPR size "${length} / 2")
+
+    # 32 bytes per line
+    set(lines "")
+    set(offset 0)
+    while (offset LESS length)
+        string(SUBSTRING "${bytes}" ${offset} 64 line)
+        string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," line "${line}")
+        string(APPEND lines "${line}\n    ")
+        math(EXPR offset "${offset} + 64")
+    endwhile ()
+
+    string(APPEND arrays "alignas(64) static constexpr unsigned char resource_${index}[] = {\n    ${lines}0x00\n};\n\n")
+    string(APPEND table "    { \"${name}\", resource_${index}, ${size} },\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+
+if (index EQUAL 0)
+    message(FATAL_ERROR "No resources to embed under ${ROOT}/resources")
+endif ()
+
+set(content "// Generated by tools/embed_resources.cmake - do not edit.\n")
+string(APPEND content "#include \"embedded.h\"\n\n#include <cstddef>\n\nnamespace cg\n{\n\n")
+string(APPEND content "${arrays}")
+string(APPEND content "extern const EmbeddedResource g_embedded_resources[] = {\n${table}};\n\n")
+string(APPEND content "extern const size_t g_embedded_resource_count = ${index};\n\n} // namespace cg\n")
+
+# Rewrite only on change so the executable is not relinked needlessly
+if (EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} previous)
+endif ()
+if (NOT "${previous}" STREQUAL "${content}")
+    file(WRITE ${OUTPUT} "${content}")
+endif ()
@@ -0,0 +1,339 @@
+#include "archive_format.h"
+#include "inflate.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/*
+ *        .
+ *          .cgpak
+ * ( src/archive_format.h).       ,
+ *  "resources/shaders/tex_v.glsl",     .
+ *
+ *   ()    deflate,     1/4.
+ *   (.cgtex)  PNG   ,
+ *         .
+ *
+ * : respack  .cgpak
+ */
+
+/*
+ *   ,   - (  deflate).
+ */
+struct BitWriter
+{
+    std::vector<unsigned char>& out;
+    uint32_t bits = 0;
+    int count = 0;
+
+    void put(uint32_t value, int length)
+    {
+        bits |= value << count;
+        count += length;
+        while (count >= 8)
+        {
+            out.push_back(static_cast<unsigned char>(bits));
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+
+    //       - 
+    void put_code(uint32_t code, int length)
+    {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; i++)
+            reversed |= ((code >> i) & 1) << (length - 1 - i);
+        put(reversed, length);
+    }
+
+    void flush(void)
+    {
+        if (count > 0)
+            out.push_back(static_cast<unsigned char>(bits));
+        bits = 0;
+        count = 0;
+    }
+};
+
+static const uint16_t length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t distance_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t distance_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+/*
+ *       (RFC 1951, 3.2.6).
+ */
+static void put_literal(BitWriter& writer, int symbol)
+{
+    if (symbol < 144)
+        writer.put_code(0x30 + symbol, 8);
+    else if (symbol < 256)
+        writer.put_code(0x190 + symbol - 144, 9);
+    else if (symbol < 280)
+        writer.put_code(symbol - 256, 7);
+    else
+        writer.put_code(0xC0 + symbol - 280, 8);
+}
+
+static void put_match(BitWriter& writer, int length, int distance)
+{
+    int code = 28;
+    while (length_base[code] > length)
+        code--;
+    put_literal(writer, 257 + code);
+    writer.put(length - length_base[code], length_extra[code]);
+
+    code = 29;
+    while (distance_base[code] > distance)
+        code--;
+    writer.put_code(code, 5);
+    writer.put(distance - distance_base[code], distance_extra[code]);
+}
+
+/*
+ *   zlib       .
+ *          32 KB.
+ *            zlib.
+ */
+static std::vector<unsigned char> deflate_zlib(const std::vector<unsigned char>& data)
+{
+    constexpr int window_size = 32768;
+    constexpr int min_match = 3;
+    constexpr int max_match = 258;
+    constexpr int max_chain = 64;
+    constexpr int hash_bits = 15;
+
+    std::vector<unsigned char> out = { 0x78, 0x9C };
+    BitWriter writer{ out };
+    writer.put(1, 1);   //  
+    writer.put(1, 2);   //  
+
+    const int size = static_cast<int>(data.size());
+    std::vector<int> head(1 << hash_bits, -1);
+    std::vector<int> previous(data.size(), -1);
+
+    auto hash = [&](int position)
+    {
+        const uint32_t value = data[position] | data[position + 1] << 8 | data[position + 2] << 16;
+        return (value * 2654435761u) >> (32 - hash_bits);
+    };
+    auto insert = [&](int position)
+    {
+        if (position + min_match > size)
+            return;
+        const uint32_t h = hash(position);
+        previous[position] = head[h];
+        head[h] = position;
+    };
+
+    int position = 0;
+    while (position < size)
+    {
+        int best_length = 0;
+        int best_distance = 0;
+        if (position + min_match <= size)
+        {
+            const int limit = std::min(max_match, size - position);
+            int candidate = head[hash(position)];
+            for (int chain = 0; candidate >= 0 && position - candidate <= window_size && chain < max_chain; chain++)
+            {
+                int length = 0;
+                while (length < limit && data[candidate + length] == data[position + length])
+                    length++;
+                if (length > best_length)
+                {
+                    best_length = length;
+                    best_distance = position - candidate;
+                    if (length == limit)
+                        break;
+                }
+                candidate = previous[candidate];
+            }
+        }
+
+        if (best_length >= min_match)
+        {
+            put_match(writer, best_length, best_distance);
+            for (int i = 0; i < best_length; i++)
+                insert(position + i);
+            position += best_length;
+        }
+        else
+        {
+            put_literal(writer, data[position]);
+            insert(position);
+            position++;
+        }
+    }
+
+    put_literal(writer, 256);
+    writer.flush();
+
+    // Adler-32 (big-endian)
+    uint32_t a = 1, b = 0;
+    for (unsigned char value : data)
+    {
+        a = (a + value) % 65521;
+        b = (b + a) % 65521;
+    }
+    const uint32_t adler = b << 16 | a;
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out.push_back(static_cast<unsigned char>(adler >> shift));
+
+    return out;
+}
+
+/*
+ *    .
+ */
+static uint64_t align(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+struct PackedFile
+{
+    std::string name;
+    std::vector<unsigned char> data;
+    uint64_t original_size = 0;
+    uint32_t compression = cg::ARCHIVE_STORED;
+};
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: respack input_directory output.cgpak" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path root = std::filesystem::path(argv[1]).lexically_normal();
+    if (root.has_filename() == false)
+        root = root.parent_path();    // "resources/" -> "resources"
+    std::error_code error;
+    if (std::filesystem::is_directory(root, error) == false)
+    {
+        std::cerr << "Not a directory: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    /*
+     *     .
+     */
+    std::vector<PackedFile> files;
+    uint64_t total_original = 0;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(root))
+    {
+        if (item.is_regular_file() == false)
+            continue;
+
+        PackedFile file;
+        file.name = (root.filename() / item.path().lexically_relative(root)).generic_string();
+
+        std::ifstream in(item.path(), std::ios::in | std::ios::binary);
+        file.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (in.bad())
+        {
+            std::cerr << "Failed to read " << item.path().string() << std::endl;
+            return 1;
+        }
+        file.original_size = file.data.size();
+        total_original += file.original_size;
+
+        const std::string extension = item.path().extension().string();
+        if (extension != ".cgtex" && extension != ".png" && file.data.size() > 0)
+        {
+            std::vector<unsigned char> compressed = deflate_zlib(file.data);
+
+            // ,        
+            std::vector<unsigned char> check(file.data.size());
+            if (cg::inflate_zlib(compressed.data(), compressed.size(), check.data(), check.size()) == false ||
+                check != file.data)
+            {
+                std::cerr << "Compression round trip failed for " << file.name << std::endl;
+                return 1;
+            }
+
+            if (compressed.size() * 4 <= file.data.size() * 3)
+            {
+                file.data = std::move(compressed);
+                file.compression = cg::ARCHIVE_ZLIB;
+            }
+        }
+
+        files.push_back(std::move(file));
+    }
+
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) { return a.name < b.name; });
+
+    /*
+     *   ,     .
+     */
+    std::vector<cg::ArchiveEntry> entries(files.size());
+    std::string names;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        entries[i].name_offset = static_cast<uint32_t>(names.size());
+        entries[i].name_length = static_cast<uint32_t>(files[i].name.size());
+        entries[i].compression = files[i].compression;
+        entries[i].size = files[i].data.size();
+        entries[i].original_size = files[i].original_size;
+        names += files[i].name;
+    }
+
+    cg::ArchiveHeader header = {};
+    std::memcpy(header.magic, cg::archive_magic, sizeof(header.magic));
+    header.version = cg::archive_version;
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.names_size = static_cast<uint32_t>(names.size());
+    header.names_offset = sizeof(header) + entries.size() * sizeof(cg::ArchiveEntry);
+
+    uint64_t offset = header.names_offset + names.size();
+    for (cg::ArchiveEntry& entry : entries)
+    {
+        offset = align(offset, cg::archive_alignment);
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    /*
+     *   .
+     */
+    std::ofstream out(argv[2], std::ios::out | std::ios::binary);
+    if (out.good() == false)
+    {
+        std::cerr << "Failed to open " << argv[2] << " for writing." << std::endl;
+        return 1;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(cg::ArchiveEntry));
+    out.write(names.data(), names.size());
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        const std::vector<char> padding(entries[i].offset - static_cast<uint64_t>(out.tellp()), 0);
+        out.write(padding.data(), padding.size());
+        out.write(reinterpret_cast<const char*>(files[i].data.data()), files[i].data.size());
+    }
+
+    std::cout << argv[2] << ": " << files.size() << " files, " <<
+        total_original / 1024 << " KB -> " << offset / 1024 << " KB" << std::endl;
+
+    return out.good() ? 0 : 1;
+}
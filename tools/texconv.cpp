@@ -0,0 +1,417 @@
+#include "srgb.h"
+#include "texture_format.h"
+#include "vendor/stb_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+ *      .
+ *  PNG/JPEG,       BC1/BC3 
+ *   .cgtex ( src/texture_format.h).
+ *
+ * : texconv [--bc1 | --bc3] .png .cgtex
+ *     BC3,    ,  BC1.
+ */
+
+/*
+ *   RGBA  ( 4 ).
+ */
+struct Image
+{
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+/*
+ *      2x2 box .
+ *       (     
+ *  ),   - .     /  .
+ */
+static Image downsample(const Image& source)
+{
+    const cg::SrgbTables& tables = cg::srgb_tables();
+    Image result;
+    result.width = std::max(1, source.width / 2);
+    result.height = std::max(1, source.height / 2);
+    result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+    for (int y = 0; y < result.height; y++)
+    {
+        for (int x = 0; x < result.width; x++)
+        {
+            const int x0 = std::min(x * 2, source.width - 1);
+            const int x1 = std::min(x * 2 + 1, source.width - 1);
+            const int y0 = std::min(y * 2, source.height - 1);
+            const int y1 = std::min(y * 2 + 1, source.height - 1);
+            const unsigned char* p00 = &source.pixels[(static_cast<size_t>(y0) * source.width + x0) * 4];
+            const unsigned char* p01 = &source.pixels[(static_cast<size_t>(y0) * source.width + x1) * 4];
+            const unsigned char* p10 = &source.pixels[(static_cast<size_t>(y1) * source.width + x0) * 4];
+            const unsigned char* p11 = &source.pixels[(static_cast<size_t>(y1) * source.width + x1) * 4];
+            unsigned char* out = &result.pixels[(static_cast<size_t>(y) * result.width + x) * 4];
+
+            for (int c = 0; c < 3; c++)
+            {
+                const float sum = tables.to_linear[p00[c]] + tables.to_linear[p01[c]] +
+                    tables.to_linear[p10[c]] + tables.to_linear[p11[c]];
+                out[c] = cg::linear_to_srgb(tables, 0.25f * sum);
+            }
+            out[3] = static_cast<unsigned char>((p00[3] + p01[3] + p10[3] + p11[3] + 2) / 4);
+        }
+    }
+
+    return result;
+}
+
+/*
+ *   4x4   .
+ *      .
+ */
+static void fetch_block(const Image& image, int block_x, int block_y, unsigned char block[16][4])
+{
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+        {
+            const int source_x = std::min(block_x * 4 + x, image.width - 1);
+            const int source_y = std::min(block_y * 4 + y, image.height - 1);
+            std::memcpy(block[y * 4 + x],
+                &image.pixels[(static_cast<size_t>(source_y) * image.width + source_x) * 4],
+                4);
+        }
+    }
+}
+
+/*
+ *   8- RGB  5:6:5.
+ */
+static uint16_t to_565(const float color[3])
+{
+    const int r = std::clamp(static_cast<int>(std::lround(color[0] * 31.0f / 255.0f)), 0, 31);
+    const int g = std::clamp(static_cast<int>(std::lround(color[1] * 63.0f / 255.0f)), 0, 63);
+    const int b = std::clamp(static_cast<int>(std::lround(color[2] * 31.0f / 255.0f)), 0, 31);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void from_565(uint16_t value, int color[3])
+{
+    const int r = (value >> 11) & 31;
+    const int g = (value >> 5) & 63;
+    const int b = value & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+/*
+ *       BC1 (8 ).
+ *           ,
+ *     -     .
+ */
+static void encode_color_block(const unsigned char block[16][4], unsigned char* out)
+{
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++)
+        for (int c = 0; c < 3; c++)
+            mean[c] += block[i][c] / 16.0f;
+
+    /*
+     *      ( ).
+     */
+    float covariance[6] = { 0.0f };     // xx, xy, xz, yy, yz, zz
+    for (int i = 0; i < 16; i++)
+    {
+        const float r = block[i][0] - mean[0];
+        const float g = block[i][1] - mean[1];
+        const float b = block[i][2] - mean[2];
+        covariance[0] += r * r;
+        covariance[1] += r * g;
+        covariance[2] += r * b;
+        covariance[3] += g * g;
+        covariance[4] += g * b;
+        covariance[5] += b * b;
+    }
+
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        const float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+        const float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+        const float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+        const float length = std::max({ std::fabs(x), std::fabs(y), std::fabs(z) });
+        if (length < 1e-6f)
+            break;
+        axis[0] = x / length;
+        axis[1] = y / length;
+        axis[2] = z / length;
+    }
+
+    float min_t = 1e30f;
+    float max_t = -1e30f;
+    for (int i = 0; i < 16; i++)
+    {
+        const float t = (block[i][0] - mean[0]) * axis[0] +
+            (block[i][1] - mean[1]) * axis[1] +
+            (block[i][2] - mean[2]) * axis[2];
+        min_t = std::min(min_t, t);
+        max_t = std::max(max_t, t);
+    }
+
+    /*
+     *  ,      (inset),  - .
+     */
+    const float inset = (max_t - min_t) / 16.0f;
+    float end0[3];
+    float end1[3];
+    for (int c = 0; c < 3; c++)
+    {
+        end0[c] = std::clamp(mean[c] + (max_t - inset) * axis[c], 0.0f, 255.0f);
+        end1[c] = std::clamp(mean[c] + (min_t + inset) * axis[c], 0.0f, 255.0f);
+    }
+
+    uint16_t color0 = to_565(end0);
+    uint16_t color1 = to_565(end1);
+    if (color0 < color1)
+        std::swap(color0, color1);   // color0 > color1     
+
+    uint32_t indices = 0;
+    if (color0 != color1)
+    {
+        int palette[4][3];
+        from_565(color0, palette[0]);
+        from_565(color1, palette[1]);
+        for (int c = 0; c < 3; c++)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            int best_distance = 1 << 30;
+            for (int p = 0; p < 4; p++)
+            {
+                int distance = 0;
+                for (int c = 0; c < 3; c++)
+                {
+                    const int d = block[i][c] - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < best_distance)
+                {
+                    best_distance = distance;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (i * 2);
+        }
+    }
+
+    out[0] = static_cast<unsigned char>(color0 & 0xFF);
+    out[1] = static_cast<unsigned char>(color0 >> 8);
+    out[2] = static_cast<unsigned char>(color1 & 0xFF);
+    out[3] = static_cast<unsigned char>(color1 >> 8);
+    for (int i = 0; i < 4; i++)
+        out[4 + i] = static_cast<unsigned char>(indices >> (i * 8));
+}
+
+/*
+ *       (BC3 alpha, 8 ).
+ *          .
+ */
+static void encode_alpha_block(const unsigned char block[16][4], unsigned char* out)
+{
+    int alpha_min = 255;
+    int alpha_max = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        alpha_min = std::min(alpha_min, static_cast<int>(block[i][3]));
+        alpha_max = std::max(alpha_max, static_cast<int>(block[i][3]));
+    }
+
+    out[0] = static_cast<unsigned char>(alpha_max);
+    out[1] = static_cast<unsigned char>(alpha_min);
+
+    uint64_t indices = 0;
+    if (alpha_max != alpha_min)
+    {
+        int palette[8];
+        palette[0] = alpha_max;
+        palette[1] = alpha_min;
+        for (int i = 2; i < 8; i++)
+            palette[i] = ((8 - i) * alpha_max + (i - 1) * alpha_min) / 7;
+
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            int best_distance = 1 << 30;
+            for (int p = 0; p < 8; p++)
+            {
+                const int distance = std::abs(block[i][3] - palette[p]);
+                if (distance < best_distance)
+                {
+                    best_distance = distance;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint64_t>(best) << (i * 3);
+        }
+    }
+
+    for (int i = 0; i < 6; i++)
+        out[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+}
+
+/*
+ *    .
+ */
+static std::vector<unsigned char> compress_level(const Image& image, uint32_t format)
+{
+    const int blocks_x = (image.width + 3) / 4;
+    const int blocks_y = (image.height + 3) / 4;
+    const uint32_t block_size = cg::compressed_block_size(format);
+
+    std::vector<unsigned char> result(static_cast<size_t>(blocks_x) * blocks_y * block_size);
+    unsigned char* out = result.data();
+
+    unsigned char block[16][4];
+    for (int y = 0; y < blocks_y; y++)
+    {
+        for (int x = 0; x < blocks_x; x++)
+        {
+            fetch_block(image, x, y, block);
+            if (format == cg::COMPRESSED_BC3)
+            {
+                encode_alpha_block(block, out);
+                encode_color_block(block, out + 8);
+            }
+            else
+            {
+                encode_color_block(block, out);
+            }
+            out += block_size;
+        }
+    }
+
+    return result;
+}
+
+/*
+ *    .
+ */
+static uint64_t align(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t format = 0;    // 0 -  
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--bc1")
+            format = cg::COMPRESSED_BC1;
+        else if (argument == "--bc3")
+            format = cg::COMPRESSED_BC3;
+        else
+            paths.push_back(argument);
+    }
+
+    if (paths.size() != 2)
+    {
+        std::cerr << "Usage: texconv [--bc1 | --bc3] input.png output.cgtex" << std::endl;
+        return 1;
+    }
+
+    /*
+     *   ,        .
+     */
+    Image image;
+    int bpp = 0;
+    stbi_set_flip_vertically_on_load(1);
+    unsigned char* pixels = stbi_load(paths[0].c_str(), &image.width, &image.height, &bpp, 4);
+    if (pixels == nullptr)
+    {
+        std::cerr << "Failed to load " << paths[0] << ": " << stbi_failure_reason() << std::endl;
+        return 1;
+    }
+    image.pixels.assign(pixels, pixels + static_cast<size_t>(image.width) * image.height * 4);
+    stbi_image_free(pixels);
+
+    if (format == 0)
+    {
+        bool has_alpha = false;
+        for (size_t i = 3; i < image.pixels.size(); i += 4)
+            has_alpha |= image.pixels[i] != 255;
+        format = has_alpha ? cg::COMPRESSED_BC3 : cg::COMPRESSED_BC1;
+    }
+
+    /*
+     *       .
+     */
+    std::vector<std::vector<unsigned char>> level_data;
+    std::vector<cg::CompressedTextureLevel> levels;
+    Image level = image;
+    while (true)
+    {
+        levels.push_back({ 0, 0, static_cast<uint32_t>(level.width), static_cast<uint32_t>(level.height) });
+        level_data.push_back(compress_level(level, format));
+
+        if (level.width == 1 && level.height == 1)
+            break;
+        level = downsample(level);
+    }
+
+    uint64_t offset = sizeof(cg::CompressedTextureHeader) + levels.size() * sizeof(cg::CompressedTextureLevel);
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        offset = align(offset, cg::compressed_texture_alignment);
+        levels[i].offset = offset;
+        levels[i].size = level_data[i].size();
+        offset += level_data[i].size();
+    }
+
+    cg::CompressedTextureHeader header = {};
+    std::memcpy(header.magic, cg::compressed_texture_magic, sizeof(header.magic));
+    header.version = cg::compressed_texture_version;
+    header.format = format;
+    header.width = static_cast<uint32_t>(image.width);
+    header.height = static_cast<uint32_t>(image.height);
+    header.levels = static_cast<uint32_t>(levels.size());
+
+    /*
+     *   .
+     */
+    std::ofstream out(paths[1], std::ios::out | std::ios::binary);
+    if (out.good() == false)
+    {
+        std::cerr << "Failed to open " << paths[1] << " for writing." << std::endl;
+        return 1;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(levels.data()), levels.size() * sizeof(cg::CompressedTextureLevel));
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        const std::vector<char> padding(levels[i].offset - static_cast<uint64_t>(out.tellp()), 0);
+        out.write(padding.data(), padding.size());
+        out.write(reinterpret_cast<const char*>(level_data[i].data()), level_data[i].size());
+    }
+
+    const size_t uncompressed = static_cast<size_t>(image.width) * image.height * 4 * 4 / 3;
+    std::cout << paths[0] << ": " << image.width << "x" << image.height << ", " <<
+        levels.size() << " levels, " << (format == cg::COMPRESSED_BC1 ? "BC1" : "BC3") << ", " <<
+        uncompressed / 1024 << " KB -> " << offset / 1024 << " KB" << std::endl;
+
+    return out.good() ? 0 : 1;
+}